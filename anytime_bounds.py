@@ -0,0 +1,317 @@
+#!/usr/bin/env python3
+"""
+Anytime progressive bounds on dk and αk
+
+Instead of waiting for a full analysis, the driver runs a sequence of
+increasingly expensive stages and publishes the current interval
+[lower, upper] for every k after each one:
+
+1. degree_sequence:  bounds from the degree sequence alone (degree_bounds.py)
+2. sampled:          min-degree peel of an edge sample; the true edge counts
+                     of its suffix sets are rigorous αk lower bounds and the
+                     rescaled sample profile is reported as an estimate
+3. approximate:      round-synchronous (1+ε) peel; its rounds are subgraphs
+                     (lower bounds), and orienting every edge towards the
+                     later round gives out-degrees o_v with
+                         e(S) ≤ Σ_{v∈S} min(o_v, |S|-1)   (upper bounds)
+4. peel:             the exact min-degree peel: dk itself, and the same
+                     upper bound with o_v = degree at removal
+5. greedy++:         repeated load-weighted peels (Boob et al.); every pass
+                     adds subgraph lower bounds and the averaged loads form
+                     a fractional orientation that tightens the upper bound
+6. exact:            tree-decomposition DP or bitset search where they apply
+
+Intervals only ever tighten. Results are delivered through a callback,
+by iterating stages(), or by polling snapshot() while start() runs the
+driver in a background thread. The driver stops as soon as every watched
+k has upper - lower ≤ tolerance.
+"""
+
+import heapq
+import threading
+import time
+import numpy as np
+from numba import njit
+from typing import Callable, Iterator, Optional
+
+from graph_csr import edges_to_csr
+from degree_bounds import degree_sequence_bounds, capped_top_sums, alpha_upper_bounds
+from large_set_arboricity import _bucket_peel_csr, _compute_dk_from_states
+from approximate_peel import approximate_peel_states
+from treewidth_dp import exact_alpha_auto
+
+STAGES = ('degree_sequence', 'sampled', 'approximate', 'peel', 'greedy++', 'exact')
+
+
+@njit(cache=True)
+def _greedy_pp_pass(offsets: np.ndarray, neighbors: np.ndarray, load: np.ndarray):
+    """
+    One Greedy++ pass: peel by load + current degree, add degrees at removal to load.
+
+    Returns:
+        (vertices_at_step, edges_at_step) recorded before each removal
+    """
+    n = len(offsets) - 1
+    vertices_at_step = np.empty(n, dtype=np.int64)
+    edges_at_step = np.empty(n, dtype=np.int64)
+    if n == 0:
+        return vertices_at_step, edges_at_step
+
+    degrees = np.empty(n, dtype=np.int64)
+    for v in range(n):
+        degrees[v] = offsets[v + 1] - offsets[v]
+    key = load + degrees
+    removed = np.zeros(n, dtype=np.bool_)
+    heap = [(key[v], np.int64(v)) for v in range(n)]
+    heapq.heapify(heap)
+
+    edges = degrees.sum() // 2
+    step = 0
+    while step < n:
+        k, v = heapq.heappop(heap)
+        if removed[v] or k != key[v]:
+            continue                        # stale entry
+        vertices_at_step[step] = n - step
+        edges_at_step[step] = edges
+        removed[v] = True
+        load[v] += degrees[v]
+        edges -= degrees[v]
+        step += 1
+        for idx in range(offsets[v], offsets[v + 1]):
+            u = neighbors[idx]
+            if not removed[u]:
+                degrees[u] -= 1
+                key[u] -= 1
+                heapq.heappush(heap, (key[u], np.int64(u)))
+    return vertices_at_step, edges_at_step
+
+
+def _suffix_states(offsets: np.ndarray, neighbors: np.ndarray, order: np.ndarray):
+    """(vertices, edges) of every suffix of a removal order, counted in the full graph."""
+    n = len(offsets) - 1
+    position = np.empty(n, dtype=np.int64)
+    position[order] = np.arange(n)
+    src = np.repeat(np.arange(n, dtype=np.int64), np.diff(offsets))
+    upper = src < neighbors
+    first = np.minimum(position[src[upper]], position[neighbors[upper]])
+    # Edges whose earlier endpoint is at position ≥ i survive in suffix i
+    edges = np.cumsum(np.bincount(first, minlength=n)[::-1])[::-1]
+    return np.arange(n, 0, -1, dtype=np.int64), edges
+
+
+class AnytimeBounds:
+    """
+    Progressive [lower, upper] intervals on dk and αk for every k.
+
+    Usage:
+        driver = AnytimeBounds(offsets, neighbors, tolerance=1, callback=print_snapshot)
+        final = driver.run()
+
+        driver.start()              # background thread
+        ... driver.snapshot() ...   # poll the latest intervals
+        driver.wait()
+    """
+
+    def __init__(self, offsets: np.ndarray, neighbors: np.ndarray,
+                 ks: Optional[np.ndarray] = None, target: str = 'alpha',
+                 tolerance: int = 0, callback: Optional[Callable[[dict], None]] = None,
+                 sample_rate: float = 0.1, epsilon: float = 0.1,
+                 greedy_iterations: int = 16, max_width: int = 10,
+                 exact_max_vertices: int = 100_000, seed: int = 0):
+        """
+        Args:
+            offsets: CSR offsets
+            neighbors: CSR neighbours
+            ks: k values that must reach the precision (default: all)
+            target: 'alpha' or 'dk', the interval the stopping rule watches
+            tolerance: Stop once upper - lower ≤ tolerance for every watched k
+            callback: Called with every published snapshot
+            sample_rate: Edge keep probability of the sampled stage
+            epsilon: Round slack of the approximate stage
+            greedy_iterations: Maximum Greedy++ passes
+            max_width: Largest decomposition width for the exact DP
+            exact_max_vertices: Skip the exact stage above this many vertices
+            seed: Random seed of the edge sample
+        """
+        if target not in ('alpha', 'dk'):
+            raise ValueError(f"Unknown target: {target} (expected 'alpha' or 'dk')")
+        self.offsets = offsets
+        self.neighbors = neighbors
+        self.n = len(offsets) - 1
+        self.m = int(offsets[-1]) // 2
+        self.ks = np.arange(self.n) if ks is None else np.asarray(ks, dtype=np.int64)
+        self.target = target
+        self.tolerance = tolerance
+        self.callback = callback
+        self.sample_rate = sample_rate
+        self.epsilon = epsilon
+        self.greedy_iterations = greedy_iterations
+        self.max_width = max_width
+        self.exact_max_vertices = exact_max_vertices
+        self.seed = seed
+
+        self.dk_lower = np.zeros(self.n, dtype=np.int64)
+        self.dk_upper = np.full(self.n, np.iinfo(np.int64).max, dtype=np.int64)
+        self.alpha_lower = np.zeros(self.n, dtype=np.int64)
+        self.alpha_upper = np.full(self.n, np.iinfo(np.int64).max, dtype=np.int64)
+        self.estimate = None
+
+        self._lock = threading.Lock()
+        self._latest = None
+        self._stop = threading.Event()
+        self._thread = None
+        self._start_time = None
+
+    # ------------------------------------------------------------------
+    # Interval updates (intervals only tighten)
+    # ------------------------------------------------------------------
+
+    def _raise_alpha(self, lower: np.ndarray) -> None:
+        np.maximum(self.alpha_lower, lower, out=self.alpha_lower)
+
+    def _lower_alpha_upper(self, max_edges: np.ndarray) -> None:
+        s = np.arange(1, self.n + 1, dtype=np.int64)
+        bound = alpha_upper_bounds(np.minimum(np.minimum(max_edges, self.m), s * (s - 1) // 2))
+        np.minimum(self.alpha_upper, bound, out=self.alpha_upper)
+
+    def _orientation_bound(self, out_degree_sum: np.ndarray, passes: int = 1) -> None:
+        """Upper bounds from an orientation's out-degrees (summed over passes)."""
+        self._lower_alpha_upper(capped_top_sums(out_degree_sum, passes) // passes)
+
+    def _settle(self) -> None:
+        # dk ≤ αk, and every dk lower bound is a subgraph density
+        np.maximum(self.alpha_lower, self.dk_lower, out=self.alpha_lower)
+        np.minimum(self.dk_upper, self.alpha_upper, out=self.dk_upper)
+
+    def gap(self) -> int:
+        """Largest upper - lower over the watched k values of the target interval."""
+        if len(self.ks) == 0:
+            return 0
+        lower, upper = ((self.alpha_lower, self.alpha_upper) if self.target == 'alpha'
+                        else (self.dk_lower, self.dk_upper))
+        return int(np.max(upper[self.ks] - lower[self.ks]))
+
+    def converged(self) -> bool:
+        return self.gap() <= self.tolerance
+
+    def _publish(self, stage: str, **extra) -> dict:
+        self._settle()
+        snapshot = {
+            'stage': stage,
+            'time': time.time() - self._start_time,
+            'dk_lower': self.dk_lower.copy(),
+            'dk_upper': self.dk_upper.copy(),
+            'alpha_lower': self.alpha_lower.copy(),
+            'alpha_upper': self.alpha_upper.copy(),
+            'estimate': None if self.estimate is None else self.estimate.copy(),
+            'gap': self.gap(),
+            'converged': self.converged()
+        }
+        snapshot.update(extra)
+        with self._lock:
+            self._latest = snapshot
+        if self.callback is not None:
+            self.callback(snapshot)
+        return snapshot
+
+    # ------------------------------------------------------------------
+    # Stages
+    # ------------------------------------------------------------------
+
+    def stages(self) -> Iterator[dict]:
+        """Run the stages in order, yielding a snapshot after each."""
+        self._start_time = time.time()
+        offsets, neighbors, n = self.offsets, self.neighbors, self.n
+        if n == 0:
+            yield self._publish('exact')
+            return
+
+        # 1. Degree sequence
+        bounds = degree_sequence_bounds(np.diff(offsets))
+        self.dk_lower[:] = bounds['dk_lower']
+        np.minimum(self.alpha_upper, bounds['dk_upper'], out=self.alpha_upper)
+        yield self._publish('degree_sequence')
+
+        # 2. Sampled: peel a sparsified graph, evaluate its suffixes exactly
+        src = np.repeat(np.arange(n, dtype=np.int64), np.diff(offsets))
+        upper = src < neighbors
+        edges = np.stack((src[upper], neighbors[upper].astype(np.int64)), axis=1)
+        keep = np.random.default_rng(self.seed).random(len(edges)) < self.sample_rate
+        sample_offsets, sample_neighbors = edges_to_csr(edges[keep], n)
+        order, _, sv, se, _ = _bucket_peel_csr(sample_offsets, sample_neighbors)
+        vertices_at_step, edges_at_step = _suffix_states(offsets, neighbors, order)
+        self._raise_alpha(_compute_dk_from_states(vertices_at_step, edges_at_step, n))
+        self.estimate = np.ceil(_compute_dk_from_states(sv, se, n) / self.sample_rate).astype(np.int64)
+        yield self._publish('sampled', sample_edges=int(keep.sum()))
+
+        # 3. Approximate round-synchronous peel
+        rv, re, layer = approximate_peel_states(offsets, neighbors, self.epsilon)
+        self._raise_alpha(_compute_dk_from_states(rv, re, n))
+        nbr_layer = layer[neighbors]
+        src_layer = layer[src]
+        later = (nbr_layer > src_layer) | ((nbr_layer == src_layer) & (neighbors > src))
+        self._orientation_bound(np.bincount(src[later], minlength=n))
+        yield self._publish('approximate', rounds=len(rv) - 1)
+
+        # 4. Exact min-degree peel
+        order, degree_at_removal, pv, pe, _ = _bucket_peel_csr(offsets, neighbors)
+        dk = _compute_dk_from_states(pv, pe, n).astype(np.int64)
+        self.dk_lower[:] = dk
+        self.dk_upper[:] = dk
+        self._orientation_bound(degree_at_removal)
+        yield self._publish('peel')
+
+        # 5. Greedy++
+        load = np.zeros(n, dtype=np.int64)
+        for iteration in range(1, self.greedy_iterations + 1):
+            gv, ge = _greedy_pp_pass(offsets, neighbors, load)
+            self._raise_alpha(_compute_dk_from_states(gv, ge, n))
+            self._orientation_bound(load, iteration)
+            yield self._publish('greedy++', iteration=iteration)
+            if self._stop.is_set() or self.converged():
+                return
+
+        # 6. Exact solvers
+        if n <= self.exact_max_vertices:
+            alpha, method = exact_alpha_auto(offsets, neighbors, self.max_width)
+            if alpha is not None:
+                self.alpha_lower[:] = alpha
+                self.alpha_upper[:] = alpha
+                yield self._publish('exact', method=method)
+
+    def run(self) -> dict:
+        """Run stages until the precision is reached, stop() is called or all stages are done."""
+        snapshot = None
+        for snapshot in self.stages():
+            if self._stop.is_set() or snapshot['converged']:
+                break
+        return snapshot
+
+    def start(self) -> None:
+        """Run the driver in a background thread (poll with snapshot())."""
+        self._stop.clear()
+        self._thread = threading.Thread(target=self.run, daemon=True)
+        self._thread.start()
+
+    def snapshot(self) -> Optional[dict]:
+        """Latest published snapshot (None before the first stage finishes)."""
+        with self._lock:
+            return self._latest
+
+    def stop(self) -> None:
+        """Ask the driver to stop after the current stage."""
+        self._stop.set()
+
+    def wait(self, timeout: Optional[float] = None) -> Optional[dict]:
+        """Wait for the background run and return the final snapshot."""
+        if self._thread is not None:
+            self._thread.join(timeout)
+        return self.snapshot()
+
+
+def print_snapshot(snapshot: dict) -> None:
+    """One-line progress report of a published snapshot."""
+    print(f"  [{snapshot['time']:7.3f}s] {snapshot['stage']:<16} "
+          f"d_0 ∈ [{snapshot['dk_lower'][0]}, {snapshot['dk_upper'][0]}]  "
+          f"α_0 ∈ [{snapshot['alpha_lower'][0]}, {snapshot['alpha_upper'][0]}]  "
+          f"max gap {snapshot['gap']}")
@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""
+Approximate (round-synchronous) peeling over CSR arrays
+
+Each round removes, all at once, every remaining vertex whose degree is at
+most (1+ε)·d̄ where d̄ = 2m/n is the average degree of the remaining graph.
+The number of rounds is O(log n / ε), and the densest round state is a
+2(1+ε)-approximation of the densest subgraph.
+
+The (vertices, edges) state after every round is recorded, so the dk
+profile can be derived exactly as for the sequential peel, only on a
+coarser set of steps.
+
+approximate_peel_states_file() runs the same rounds semi-externally: only
+O(n) state is kept in memory and the neighbour array of a CSR cache file
+is streamed from disk once per round (block_reader.BlockReader).
+"""
+
+import math
+import time
+import numpy as np
+from numba import njit
+from typing import Optional, Tuple
+
+from block_reader import BlockReader, print_read_stats
+from graph_csr import array_index, load_arrays, view_degrees
+from h_partition import _mark_frontier, _remove_frontier
+
+# Layer of vertices outside an induced-subgraph view while peeling
+_OUTSIDE = np.iinfo(np.int32).max
+
+
+def round_threshold(vertices: int, edges: int, epsilon: float) -> int:
+    """
+    Degree threshold of one round: ⌊(1+ε)·2m/n⌋.
+
+    Shared by the single-process and sharded engines so both take identical rounds.
+    """
+    if vertices == 0:
+        return 0
+    return int(math.floor((1.0 + epsilon) * 2.0 * edges / vertices))
+
+
+def approximate_peel_states(offsets: np.ndarray, neighbors: np.ndarray,
+                            epsilon: float = 0.1,
+                            mask: Optional[np.ndarray] = None) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """
+    Run approximate peeling and record the graph state after every round.
+
+    Args:
+        offsets: CSR offsets (int64[n+1])
+        neighbors: CSR neighbours (int32[2m])
+        epsilon: Round threshold slack ε > 0
+        mask: Peel only the induced subgraph on these vertices (bool[n])
+
+    Returns:
+        (vertices_at_round, edges_at_round, round_of_vertex), with
+        round_of_vertex = -1 outside the view
+    """
+    n = len(offsets) - 1
+    layer = np.full(n, -1, dtype=np.int32)
+    frontier = np.zeros(n, dtype=bool)
+
+    if mask is None:
+        degrees = np.diff(offsets).astype(np.int32)
+        vertices = n
+    else:
+        # Vertices outside the view never join a frontier, so they are
+        # never counted as lost neighbours; park them in a layer of their own
+        degrees = view_degrees(offsets, neighbors, mask).astype(np.int32)
+        layer[~mask] = _OUTSIDE
+        vertices = int(mask.sum())
+    edges = int(degrees.sum(dtype=np.int64)) // 2
+    vertices_at_round = [vertices]
+    edges_at_round = [edges]
+
+    rounds = 0
+    while vertices > 0:
+        threshold = round_threshold(vertices, edges, epsilon)
+        removed = _mark_frontier(degrees, layer, threshold, frontier)
+        _remove_frontier(offsets, neighbors, degrees, layer, frontier, rounds)
+        rounds += 1
+
+        vertices -= removed
+        edges = int(degrees[layer < 0].sum(dtype=np.int64)) // 2
+        vertices_at_round.append(vertices)
+        edges_at_round.append(edges)
+
+    if mask is not None:
+        layer[~mask] = -1
+
+    return (np.array(vertices_at_round, dtype=np.int32),
+            np.array(edges_at_round, dtype=np.int32),
+            layer)
+
+
+@njit(nogil=True, cache=True)
+def _pull_block(offsets: np.ndarray, block: np.ndarray, base: int, v: int,
+                layer: np.ndarray, frontier: np.ndarray, lost: np.ndarray) -> int:
+    """
+    Count frontier neighbours of remaining vertices over one block of the
+    neighbour array, block[i] = neighbors[base + i]; v is the vertex owning
+    neighbors[base]. Returns the vertex owning the first entry after the block.
+    """
+    n = len(offsets) - 1
+    end = base + len(block)
+    while v < n and offsets[v + 1] <= base:
+        v += 1
+    while v < n and offsets[v] < end:
+        lo = max(offsets[v], base)
+        hi = min(offsets[v + 1], end)
+        if layer[v] < 0 and not frontier[v]:
+            count = 0
+            for idx in range(lo, hi):
+                if frontier[block[idx - base]]:
+                    count += 1
+            lost[v] += count
+        if offsets[v + 1] > end:
+            break
+        v += 1
+    return v
+
+
+def approximate_peel_states_file(path: str, epsilon: float = 0.1, reader=None,
+                                 verbose: bool = False) -> dict:
+    """
+    Approximate peeling of a CSR cache file with the neighbour array on disk.
+
+    Semi-external: offsets, degrees and layers (O(n)) are held in memory,
+    the neighbour array (O(m)) is streamed sequentially once per round
+    through a read-ahead BlockReader. Rounds and states are identical to
+    approximate_peel_states().
+
+    Args:
+        path: File written by save_arrays() with 'offsets' and 'neighbors'
+        epsilon: Round threshold slack ε > 0
+        reader: block_reader.BlockReader (default: a new 'auto' reader)
+        verbose: Print rounds and read bandwidth
+
+    Returns:
+        Dictionary with vertices_at_round, edges_at_round, round_of_vertex,
+        rounds, io (reader statistics) and time
+    """
+    start_time = time.time()
+    own_reader = reader is None
+    if own_reader:
+        reader = BlockReader()
+    try:
+        dtype, length, offset = array_index(path)['neighbors']
+        offsets = np.array(load_arrays(path, mmap=True)['offsets'], dtype=np.int64)
+        n = len(offsets) - 1
+
+        layer = np.full(n, -1, dtype=np.int32)
+        frontier = np.zeros(n, dtype=bool)
+        lost = np.zeros(n, dtype=np.int32)
+        degrees = np.diff(offsets).astype(np.int32)
+        vertices = n
+        edges = int(degrees.sum(dtype=np.int64)) // 2
+        vertices_at_round = [vertices]
+        edges_at_round = [edges]
+
+        rounds = 0
+        while vertices > 0:
+            threshold = round_threshold(vertices, edges, epsilon)
+            removed = _mark_frontier(degrees, layer, threshold, frontier)
+            if edges > 0:
+                lost[:] = 0
+                base = 0
+                v = 0
+                for block in reader.read_array(path, offset, dtype, length):
+                    v = _pull_block(offsets, block, base, v, layer, frontier, lost)
+                    base += len(block)
+                degrees -= lost
+            layer[frontier] = rounds
+            rounds += 1
+
+            vertices -= removed
+            edges = int(degrees[layer < 0].sum(dtype=np.int64)) // 2
+            vertices_at_round.append(vertices)
+            edges_at_round.append(edges)
+            if verbose:
+                print(f"  round {rounds}: removed {removed:,}, remaining {vertices:,} vertices, {edges:,} edges")
+
+        io = reader.stats()
+    finally:
+        if own_reader:
+            reader.close()
+
+    elapsed = time.time() - start_time
+    if verbose:
+        print(f"✓ {rounds} rounds in {elapsed:.2f}s")
+        print_read_stats(io)
+
+    return {
+        'vertices_at_round': np.array(vertices_at_round, dtype=np.int32),
+        'edges_at_round': np.array(edges_at_round, dtype=np.int32),
+        'round_of_vertex': layer,
+        'rounds': rounds,
+        'io': io,
+        'time': elapsed,
+    }
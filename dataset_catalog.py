@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+"""
+Measured dataset catalog for planning batches and memory admission
+
+SNAPLoader.ingest() records exact numbers per dataset in a JSON file in
+the cache directory ({cache_dir}/catalog.json):
+
+    n, m                       simple graph after preprocessing (self-loops
+                               and duplicate edges dropped, as in the CSR cache)
+    largest_component(_edges)  size of the graph SNAPLoader.load() returns
+    max_degree, degeneracy     from the statistics sweep and the peel
+    edge_file_bytes, csr_bytes cache file sizes
+    csr_build_seconds          parse + CSR build (the last time it ran)
+    load_seconds               opening the CSR, including any build
+    peel_seconds               full minimum-degree peel on the CSR
+    analysis_peak_bytes        peak resident memory and wall time of one
+    analysis_seconds           networkx load + analysis in a process of its
+                               own (recorded by main_analysis.py)
+    fingerprint, measured_at
+
+Estimates derive only from these numbers. Resident memory of a CSR run is
+the CSR file (it is memory-mapped whole) plus the peel's working arrays,
+which are fixed per vertex:
+
+    degrees, nxt, prv (int64)                            24 bytes
+    order, degree_at_removal, states, coreness (int32)   20 bytes
+    mask, removed (bool)                                  2 bytes
+    bucket heads (int64)                                  8 bytes per degree value
+
+A networkx run costs many times more per edge than the CSR, so it is not
+derived from the numbers above: estimate(run='networkx') returns the
+measured peak of its last run, and nothing until one has been measured.
+
+plan_batches() packs datasets into waves that fit a memory budget and a
+worker count, longest measured run first. Datasets without a catalog
+entry are not guessed at: each runs alone in a wave of its own.
+"""
+
+import json
+import os
+import time
+from typing import Dict, Iterable, List, Optional
+
+
+PEEL_BYTES_PER_VERTEX = 46
+PEEL_BYTES_PER_DEGREE = 8
+RUNS = ('csr', 'networkx')
+
+
+class DatasetCatalog:
+    """
+    JSON-backed catalog of measured dataset statistics.
+    """
+
+    def __init__(self, path: str):
+        """
+        Open (or start) a catalog file.
+
+        Args:
+            path: Catalog file, created on the first record()
+        """
+        self.path = path
+        self.entries: Dict[str, dict] = {}
+        if os.path.exists(path):
+            with open(path) as f:
+                self.entries = json.load(f)
+
+    def __contains__(self, name: str) -> bool:
+        return self.get(name) is not None
+
+    def get(self, name: str) -> Optional[dict]:
+        """Catalog entry of a dataset, or None if it was never fully ingested."""
+        entry = self.entries.get(name)
+        return entry if entry is not None and 'peel_seconds' in entry else None
+
+    def record(self, name: str, **fields) -> dict:
+        """
+        Merge measured fields into a dataset's entry and save the catalog.
+
+        Args:
+            name: Dataset name
+            **fields: JSON-serialisable values
+
+        Returns:
+            The updated entry
+        """
+        entry = self.entries.setdefault(name, {})
+        entry.update(fields)
+        entry['measured_at'] = time.strftime('%Y-%m-%dT%H:%M:%S')
+
+        # Write then rename, so a crash never leaves a truncated catalog
+        tmp = self.path + '.tmp'
+        with open(tmp, 'w') as f:
+            json.dump(self.entries, f, indent=2, sort_keys=True)
+        os.replace(tmp, self.path)
+        return entry
+
+    def estimate(self, name: str, run: str = 'csr') -> Optional[dict]:
+        """
+        Memory and time estimate of a run from measured values.
+
+        Args:
+            name: Dataset name
+            run: 'csr' (load + peel of the CSR cache) or 'networkx'
+                 (networkx load + analysis, as measured by main_analysis.py)
+
+        Returns:
+            Dictionary with memory_bytes and seconds, or None if not measured
+        """
+        if run not in RUNS:
+            raise ValueError(f"Unknown run: {run}\nAvailable: {list(RUNS)}")
+        if run == 'networkx':
+            entry = self.entries.get(name)
+            if entry is None or 'analysis_peak_bytes' not in entry:
+                return None
+            return {'memory_bytes': entry['analysis_peak_bytes'],
+                    'seconds': entry['analysis_seconds']}
+
+        entry = self.get(name)
+        if entry is None:
+            return None
+        memory = (entry['csr_bytes']
+                  + PEEL_BYTES_PER_VERTEX * entry['n']
+                  + PEEL_BYTES_PER_DEGREE * (entry['max_degree'] + 1))
+        return {'memory_bytes': memory,
+                'seconds': entry['load_seconds'] + entry['peel_seconds']}
+
+
+def plan_batches(catalog: DatasetCatalog, names: Iterable[str],
+                 memory_budget: int, workers: int = 1, run: str = 'csr') -> List[List[str]]:
+    """
+    Group datasets into waves that run concurrently within a memory budget.
+
+    Measured datasets are placed longest first (by estimated seconds) into
+    the first wave with a free worker and enough memory left; a dataset
+    larger than the whole budget gets a wave of its own. Datasets missing
+    from the catalog each get a wave of their own after the measured ones.
+
+    Args:
+        catalog: Measured statistics
+        names: Datasets to run
+        memory_budget: Bytes available to one wave
+        workers: Maximum datasets per wave
+        run: Kind of run to plan for (see DatasetCatalog.estimate)
+
+    Returns:
+        List of waves, each a list of dataset names
+    """
+    measured = []
+    unknown = []
+    for name in names:
+        estimate = catalog.estimate(name, run)
+        if estimate is None:
+            unknown.append(name)
+        else:
+            measured.append((estimate['seconds'], estimate['memory_bytes'], name))
+    measured.sort(key=lambda item: (-item[0], -item[1], item[2]))
+
+    waves = []
+    free = []
+    for _, memory, name in measured:
+        for i, wave in enumerate(waves):
+            if len(wave) < workers and memory <= free[i]:
+                wave.append(name)
+                free[i] -= memory
+                break
+        else:
+            waves.append([name])
+            free.append(memory_budget - memory)
+
+    return waves + [[name] for name in unknown]
+
+
+def print_catalog(catalog: DatasetCatalog, names: Optional[Iterable[str]] = None) -> None:
+    """
+    Print the measured statistics and estimates of catalog entries.
+
+    Args:
+        catalog: Catalog to print
+        names: Datasets to show (default: all entries)
+    """
+    names = sorted(catalog.entries) if names is None else list(names)
+    print(f"{'Dataset':<20} {'n':>10} {'m':>11} {'d_max':>7} {'d0':>5} "
+          f"{'CSR MB':>8} {'load s':>8} {'peel s':>8} {'est. MB':>8}")
+    for name in names:
+        entry = catalog.get(name)
+        if entry is None:
+            print(f"{name:<20} {'(not ingested)':>10}")
+            continue
+        estimate = catalog.estimate(name)
+        print(f"{name:<20} {entry['n']:>10,} {entry['m']:>11,} {entry['max_degree']:>7,} "
+              f"{entry['degeneracy']:>5} {entry['csr_bytes'] / 2**20:>8.1f} "
+              f"{entry['load_seconds']:>8.2f} {entry['peel_seconds']:>8.2f} "
+              f"{estimate['memory_bytes'] / 2**20:>8.1f}")
+
+
+if __name__ == "__main__":
+    import sys
+    from snap_api import SNAPLoader
+
+    # python dataset_catalog.py [dataset ...]   ingest datasets, then print the catalog
+    loader = SNAPLoader()
+    for dataset_name in sys.argv[1:]:
+        loader.ingest(dataset_name)
+    print()
+    print_catalog(loader.catalog)
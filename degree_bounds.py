@@ -0,0 +1,256 @@
+#!/usr/bin/env python3
+"""
+Degree-sequence-only bounds on degeneracy and the dk curve
+
+For triage across many datasets: one streaming pass collects the degree
+sequence (O(n) memory, counting only, no adjacency), and rigorous bounds
+follow from the sorted sequence d_1 ≥ d_2 ≥ ... ≥ d_n and m:
+
+Upper bounds (any S with |S| = s):
+    e(S) ≤ U(s) = min(m, ⌊Σ_{i≤s} min(d_i, s-1) / 2⌋)
+    dk ≤ αk ≤ max_{s>k} ⌈2U(s)/s⌉
+    degeneracy ≤ max_c min(c-1, d_c, ⌊2U(c)/c⌋)      (a k-core on c vertices)
+
+Lower bounds (the min-degree peel itself):
+    E_n = m and the vertex removed from an s-vertex state has current
+    degree ≤ min(d_s, ⌊2E_s/s⌋, s-1), so
+    L_n = m,  L_{s-1} = L_s - min(d_s, ⌊2L_s/s⌋, s-1)  ≤  E_{s-1}
+    dk ≥ max_{s>k} ⌈2L_s/s⌉,  degeneracy ≥ max_s ⌈L_s/s⌉
+
+Sources:
+- binary CSR cache (save_arrays()): only the offsets array is read
+- edge-list file: degrees are counted per line; duplicate lines cannot be
+  removed without O(m) memory, so the caller states how often an edge may
+  be listed (multiplicity, e.g. 2 for files listing both directions).
+  Upper bounds use the counted degrees, lower bounds the counted degrees
+  and m divided by the multiplicity.
+"""
+
+import os
+import time
+import numpy as np
+from numba import njit
+from typing import Optional, Tuple
+
+from graph_csr import iter_edge_chunks, load_arrays, _MAGIC
+
+
+def degree_sequence_from_csr_file(path: str) -> np.ndarray:
+    """
+    Degree sequence of a binary CSR cache file (reads the offsets only).
+
+    Args:
+        path: File written by save_arrays() with an 'offsets' array
+
+    Returns:
+        int64[n] degrees
+    """
+    offsets = load_arrays(path, mmap=True)['offsets']
+    return np.diff(np.asarray(offsets, dtype=np.int64))
+
+
+def degree_sequence_from_edge_file(path: str, chunk_lines: int = 1 << 20, reader=None) -> np.ndarray:
+    """
+    Degree sequence of an edge-list file by streaming line counts.
+
+    Self-loops are skipped; duplicate lines are counted (see module notes).
+    Memory is one counter per distinct raw id, whatever the id range.
+
+    Args:
+        path: Edge-list file (plain or .gz)
+        chunk_lines: Lines per streamed chunk
+        reader: Optional block_reader.BlockReader (see iter_edge_chunks)
+
+    Returns:
+        int64 degrees of the vertices that occur in the file
+    """
+    # Counts per distinct raw id in a sorted table; per-chunk counts wait in
+    # a side list until they outgrow an eighth of it, then are folded in
+    keys = np.zeros(0, dtype=np.int64)
+    counts = np.zeros(0, dtype=np.int64)
+    pending = []
+    pending_size = 0
+    for chunk in iter_edge_chunks(path, chunk_lines, reader):
+        chunk = chunk[chunk[:, 0] != chunk[:, 1]].reshape(-1)
+        if len(chunk) == 0:
+            continue
+        pending.append(np.unique(chunk, return_counts=True))
+        pending_size += len(pending[-1][0])
+        if pending_size > max(1 << 20, len(keys) // 8):
+            keys, counts = _fold_counts(keys, counts, pending)
+            pending = []
+            pending_size = 0
+    _, counts = _fold_counts(keys, counts, pending)
+    return counts
+
+
+def _fold_counts(keys: np.ndarray, counts: np.ndarray, pending: list) -> Tuple[np.ndarray, np.ndarray]:
+    """Merge (ids, counts) batches into the sorted (keys, counts) table."""
+    if not pending:
+        return keys, counts
+    all_keys = np.concatenate([keys] + [k for k, _ in pending])
+    all_counts = np.concatenate([counts] + [c for _, c in pending])
+    order = np.argsort(all_keys, kind='stable')
+    all_keys = all_keys[order]
+    starts = np.flatnonzero(np.r_[True, all_keys[1:] != all_keys[:-1]])
+    return all_keys[starts], np.add.reduceat(all_counts[order], starts)
+
+
+@njit(cache=True)
+def _peel_lower_bounds(desc: np.ndarray, m: int) -> np.ndarray:
+    """L_s for s = 0 .. n from the descending degree sequence."""
+    n = len(desc)
+    L = np.zeros(n + 1, dtype=np.int64)
+    L[n] = m
+    for s in range(n, 0, -1):
+        removed = min(desc[s - 1], (2 * L[s]) // s, s - 1)
+        L[s - 1] = max(0, L[s] - removed)
+    return L
+
+
+def capped_top_sums(values: np.ndarray, scale: int = 1) -> np.ndarray:
+    """
+    Σ of the s largest values, each capped at scale·(s-1), for s = 1 .. n.
+
+    With per-vertex degrees (scale 1) this is twice an upper bound on e(S),
+    |S| = s; with the out-degrees of an orientation summed over T passes
+    (scale T) it is T times one.
+
+    Args:
+        values: Non-negative integers (any order)
+        scale: Cap multiplier
+
+    Returns:
+        int64[n], entry s-1 for sets of size s
+    """
+    desc = np.sort(np.asarray(values, dtype=np.int64))[::-1]
+    n = len(desc)
+    s = np.arange(1, n + 1, dtype=np.int64)
+    prefix = np.zeros(n + 1, dtype=np.int64)
+    np.cumsum(desc, out=prefix[1:])
+    # Values at or above the cap form a prefix of the descending order
+    at_cap = np.minimum(s, np.searchsorted(-desc, -scale * (s - 1), side='right'))
+    return at_cap * scale * (s - 1) + prefix[s] - prefix[at_cap]
+
+
+def alpha_upper_bounds(max_edges: np.ndarray) -> np.ndarray:
+    """
+    αk ≤ max_{s>k} ⌈2U(s)/s⌉ from per-size edge bounds U (entry s-1 for size s).
+
+    Returns:
+        int64[n], entry k
+    """
+    s = np.arange(1, len(max_edges) + 1, dtype=np.int64)
+    return np.maximum.accumulate((-(-2 * np.asarray(max_edges, dtype=np.int64) // s))[::-1])[::-1]
+
+
+def degree_sequence_bounds(degrees: np.ndarray, multiplicity: int = 1) -> dict:
+    """
+    Bounds on degeneracy, d_0 and dk for every k from a degree sequence.
+
+    Args:
+        degrees: Vertex degrees (any order)
+        multiplicity: Largest number of times an edge may have been counted
+                      into every degree (1 for a simple graph)
+
+    Returns:
+        Dictionary with dk_lower/dk_upper (int64[n], index k),
+        degeneracy_lower/upper, d0_lower/upper, n, and m / m_lower (the
+        counted edges and the fewest distinct edges they can stand for)
+    """
+    upper_deg = np.sort(np.asarray(degrees, dtype=np.int64))[::-1]
+    n = len(upper_deg)
+    m_upper = int(upper_deg.sum()) // 2
+    lower_deg = -(-upper_deg // multiplicity)
+    m_lower = -(-m_upper // multiplicity)
+    if n == 0:
+        empty = np.zeros(0, dtype=np.int64)
+        return {'n': 0, 'm': 0, 'm_lower': 0, 'dk_lower': empty, 'dk_upper': empty,
+                'd0_lower': 0, 'd0_upper': 0, 'degeneracy_lower': 0, 'degeneracy_upper': 0}
+
+    # U(s): top-s degrees capped at s-1
+    s = np.arange(1, n + 1, dtype=np.int64)
+    U = np.minimum(m_upper, capped_top_sums(upper_deg) // 2)
+    alpha_upper = alpha_upper_bounds(U)
+    degeneracy_upper = int(np.max(np.minimum(np.minimum(s - 1, upper_deg), 2 * U // s)))
+
+    # L_s: edges the min-degree peel must still hold at s vertices
+    L = _peel_lower_bounds(lower_deg, m_lower)[1:]
+    dk_lower = np.maximum.accumulate((-(-2 * L // s))[::-1])[::-1]
+    degeneracy_lower = int(np.max(-(-L // s)))
+
+    return {
+        'n': n,
+        'm': m_upper,
+        'm_lower': m_lower,
+        'dk_lower': dk_lower,
+        'dk_upper': alpha_upper,
+        'd0_lower': int(dk_lower[0]),
+        'd0_upper': int(alpha_upper[0]),
+        'degeneracy_lower': degeneracy_lower,
+        'degeneracy_upper': degeneracy_upper
+    }
+
+
+def fast_bounds(path: str, multiplicity: int = 1, verbose: bool = True) -> dict:
+    """
+    Degree-sequence bounds straight from a dataset file, without loading adjacency.
+
+    Args:
+        path: Binary CSR cache (save_arrays()) or edge-list file (plain or .gz)
+        multiplicity: For edge lists, how often one edge may be listed
+                      (ignored for CSR caches, which are simple)
+        verbose: Print the bounds
+
+    Returns:
+        degree_sequence_bounds() dictionary plus source and time
+    """
+    start_time = time.time()
+    with open(path, 'rb') as f:
+        is_csr = f.read(len(_MAGIC)) == _MAGIC
+    if is_csr:
+        degrees = degree_sequence_from_csr_file(path)
+        multiplicity = 1
+    else:
+        degrees = degree_sequence_from_edge_file(path)
+    bounds = degree_sequence_bounds(degrees, multiplicity)
+    bounds['source'] = 'csr' if is_csr else 'edge_list'
+    bounds['time'] = time.time() - start_time
+
+    if verbose:
+        print(f"✓ Degree-sequence bounds for {os.path.basename(path)} ({bounds['source']}) "
+              f"in {bounds['time']:.3f} seconds")
+        if bounds['m_lower'] == bounds['m']:
+            print(f"  n = {bounds['n']:,}, m = {bounds['m']:,}")
+        else:
+            print(f"  n = {bounds['n']:,}, m ∈ [{bounds['m_lower']:,}, {bounds['m']:,}]")
+        print(f"  d_0 ∈ [{bounds['d0_lower']}, {bounds['d0_upper']}]")
+        print(f"  degeneracy ∈ [{bounds['degeneracy_lower']}, {bounds['degeneracy_upper']}]")
+
+    return bounds
+
+
+def bounds_at(bounds: dict, k: int) -> Tuple[int, int]:
+    """(lower, upper) bound on dk; for k ≥ n both are 0."""
+    if k >= bounds['n']:
+        return 0, 0
+    return int(bounds['dk_lower'][k]), int(bounds['dk_upper'][k])
+
+
+def main(paths: Optional[list] = None):
+    """Print degree-sequence bounds for the files given on the command line."""
+    import sys
+
+    paths = paths if paths is not None else sys.argv[1:]
+    if not paths:
+        print("Usage: python degree_bounds.py <edge list | csr cache> [...]")
+        return
+    print(f"\n{'='*70}")
+    print("DEGREE-SEQUENCE BOUNDS")
+    print(f"{'='*70}")
+    for path in paths:
+        fast_bounds(path)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,378 @@
+#!/usr/bin/env python3
+"""
+CSR (Compressed Sparse Row) helpers for the Numba engines
+
+An undirected graph with n vertices and m edges is stored as:
+    offsets:   int64[n+1], neighbours of v are neighbors[offsets[v]:offsets[v+1]]
+    neighbors: int32[2m], each edge appears once from each endpoint
+    edge_ids:  int32[2m] (optional), index of the edge in the source edge array
+
+Induced-subgraph views: a vertex subset S is passed to the engines as a
+boolean mask over the full CSR (see view_mask()). Kernels skip masked-out
+neighbours as they go, so no copy is made; induced_csr() compacts S into
+its own CSR when S is small enough that scanning full adjacency lists of
+S would be mostly wasted.
+"""
+
+import gzip
+import itertools
+import struct
+import warnings
+import numpy as np
+from typing import Dict, Iterator, Optional, Tuple
+
+
+def edges_to_csr(edges: np.ndarray, n: int, with_edge_ids: bool = False) -> Tuple[np.ndarray, ...]:
+    """
+    Build a symmetric CSR from an (m, 2) edge array.
+
+    Args:
+        edges: Integer array of shape (m, 2), each undirected edge listed once
+        n: Number of vertices
+        with_edge_ids: Also return the edge index of every CSR entry
+
+    Returns:
+        (offsets, neighbors) or (offsets, neighbors, edge_ids)
+    """
+    edges = np.asarray(edges, dtype=np.int64).reshape(-1, 2)
+    m = len(edges)
+
+    src = np.concatenate((edges[:, 0], edges[:, 1]))
+    dst = np.concatenate((edges[:, 1], edges[:, 0]))
+
+    # Stable sort by source keeps each adjacency list in edge order
+    perm = np.argsort(src, kind='stable')
+
+    offsets = np.zeros(n + 1, dtype=np.int64)
+    np.cumsum(np.bincount(src, minlength=n), out=offsets[1:])
+    neighbors = dst[perm].astype(np.int32)
+
+    if with_edge_ids:
+        edge_ids = (perm % m).astype(np.int32) if m > 0 else np.zeros(0, dtype=np.int32)
+        return offsets, neighbors, edge_ids
+
+    return offsets, neighbors
+
+
+def igraph_to_csr(G, with_edge_ids: bool = False) -> Tuple[np.ndarray, ...]:
+    """
+    Build a symmetric CSR from an igraph Graph's edge list export.
+
+    Args:
+        G: igraph Graph (undirected)
+        with_edge_ids: Also return igraph edge ids of every CSR entry
+
+    Returns:
+        (offsets, neighbors) or (offsets, neighbors, edge_ids)
+    """
+    edges = np.array(G.get_edgelist(), dtype=np.int64).reshape(-1, 2)
+    return edges_to_csr(edges, G.vcount(), with_edge_ids)
+
+
+def networkx_to_csr(G, keep_self_loops: bool = False) -> Tuple[np.ndarray, np.ndarray, list]:
+    """
+    Build a symmetric CSR from a networkx graph with arbitrary node labels.
+
+    Args:
+        G: networkx Graph (parallel edges of a MultiGraph are kept)
+        keep_self_loops: Keep self-loops (as two entries u == v); dropped by default
+
+    Returns:
+        (offsets, neighbors, nodes) with nodes[i] the label of vertex i
+    """
+    nodes = list(G.nodes())
+    index = {v: i for i, v in enumerate(nodes)}
+    edges = np.array([(index[u], index[v]) for u, v in G.edges() if keep_self_loops or u != v],
+                     dtype=np.int64).reshape(-1, 2)
+    offsets, neighbors = edges_to_csr(edges, len(nodes))
+    return offsets, neighbors, nodes
+
+
+def view_mask(n: int, subset) -> np.ndarray:
+    """
+    Boolean vertex mask of an induced-subgraph view.
+
+    Args:
+        n: Number of vertices of the full graph
+        subset: Boolean mask of length n, or array/list of vertex ids
+
+    Returns:
+        bool[n] mask
+    """
+    subset = np.asarray(subset)
+    if subset.dtype == np.bool_:
+        if len(subset) != n:
+            raise ValueError(f"Vertex mask has length {len(subset)}, expected {n}")
+        return subset
+    mask = np.zeros(n, dtype=bool)
+    mask[subset.astype(np.int64)] = True
+    return mask
+
+
+def view_degrees(offsets: np.ndarray, neighbors: np.ndarray, mask: np.ndarray) -> np.ndarray:
+    """
+    Degrees inside the induced subgraph of a view (0 outside the view).
+
+    Only the adjacency lists of view vertices are read.
+
+    Args:
+        offsets: CSR offsets
+        neighbors: CSR neighbours
+        mask: View mask (see view_mask())
+
+    Returns:
+        int64[n] degrees
+    """
+    vertices = np.flatnonzero(mask)
+    lengths = offsets[vertices + 1] - offsets[vertices]
+    starts = np.repeat(offsets[vertices] - np.cumsum(lengths) + lengths, lengths)
+    inside = np.zeros(lengths.sum() + 1, dtype=np.int64)
+    np.cumsum(mask[neighbors[starts + np.arange(lengths.sum())]], out=inside[1:])
+
+    ends = np.cumsum(lengths)
+    degrees = np.zeros(len(mask), dtype=np.int64)
+    degrees[vertices] = inside[ends] - inside[ends - lengths]
+    return degrees
+
+
+def induced_csr(offsets: np.ndarray, neighbors: np.ndarray,
+                vertices: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Compact the induced subgraph on a vertex subset into its own CSR.
+
+    Only the adjacency lists of the subset are read, so the cost is
+    O(|S| + sum of their degrees), independent of the full graph size.
+
+    Args:
+        offsets: CSR offsets
+        neighbors: CSR neighbours
+        vertices: Sorted array of vertex ids; local id i is vertices[i]
+
+    Returns:
+        (offsets, neighbors) of the induced subgraph in local ids
+    """
+    vertices = np.asarray(vertices, dtype=np.int64)
+    lengths = offsets[vertices + 1] - offsets[vertices]
+    starts = np.repeat(offsets[vertices] - np.cumsum(lengths) + lengths, lengths)
+    nbrs = neighbors[starts + np.arange(lengths.sum())]
+    src = np.repeat(np.arange(len(vertices)), lengths)
+
+    # Keep entries whose neighbour is in the subset
+    local = np.searchsorted(vertices, nbrs)
+    local[local == len(vertices)] = 0
+    keep = vertices[local] == nbrs if len(vertices) > 0 else np.zeros(0, dtype=bool)
+
+    sub_offsets = np.zeros(len(vertices) + 1, dtype=np.int64)
+    np.cumsum(np.bincount(src[keep], minlength=len(vertices)), out=sub_offsets[1:])
+    return sub_offsets, local[keep].astype(np.int32)
+
+
+def _parse_edge_lines(lines) -> Optional[np.ndarray]:
+    """Parse edge-list lines into an int64 (c, 2) array; None if there are no pairs."""
+    # Fast path: parse the whole block at once when every line is a pair
+    body = [line for line in lines if line.strip() and line[0] != '#']
+    try:
+        with warnings.catch_warnings():
+            warnings.simplefilter('ignore')
+            values = np.fromstring(''.join(body), dtype=np.int64, sep=' ')
+    except ValueError:
+        values = None
+    if values is not None and len(values) == 2 * len(body):
+        return values.reshape(-1, 2) if len(body) > 0 else None
+
+    pairs = []
+    for line in lines:
+        if not line or line[0] == '#':
+            continue
+        parts = line.split()
+        if len(parts) >= 2:
+            try:
+                pairs.append((int(parts[0]), int(parts[1])))
+            except ValueError:
+                continue  # Skip malformed lines
+
+    return np.array(pairs, dtype=np.int64) if pairs else None
+
+
+def iter_edge_chunks(path: str, chunk_lines: int = 1 << 20, reader=None) -> Iterator[np.ndarray]:
+    """
+    Stream an edge-list file (plain or .gz, '#' comments) in chunks.
+
+    Args:
+        path: Edge-list file, one "u v" pair per line
+        chunk_lines: Number of lines read per chunk
+        reader: block_reader.BlockReader for plain files; chunks are then
+            the whole lines of each read-ahead block instead of chunk_lines
+
+    Yields:
+        int64 arrays of shape (c, 2) with raw vertex ids
+    """
+    if reader is not None and not path.endswith('.gz'):
+        # Split blocks at the last newline; the partial line moves on
+        carry = b''
+        for block in reader.blocks(path):
+            data = carry + block.tobytes()
+            cut = data.rfind(b'\n') + 1
+            carry = data[cut:]
+            chunk = _parse_edge_lines(data[:cut].decode().splitlines(keepends=True))
+            if chunk is not None:
+                yield chunk
+        if carry:
+            chunk = _parse_edge_lines([carry.decode()])
+            if chunk is not None:
+                yield chunk
+        return
+
+    opener = gzip.open if path.endswith('.gz') else open
+    with opener(path, 'rt') as f:
+        while True:
+            lines = list(itertools.islice(f, chunk_lines))
+            if not lines:
+                break
+            chunk = _parse_edge_lines(lines)
+            if chunk is not None:
+                yield chunk
+
+
+# Binary array container: one file holding several named arrays, each block
+# 64-byte aligned so it can be opened with np.memmap without copying.
+#
+#   magic (8 bytes) | count (uint64)
+#   count × [name (32 bytes) | dtype (8 bytes) | length (uint64) | offset (uint64)]
+#   data blocks
+_MAGIC = b'LSAARR01'
+_ALIGN = 64
+
+
+def save_arrays(path: str, arrays: Dict[str, np.ndarray]) -> int:
+    """
+    Write named 1-D arrays into a single mmappable file.
+
+    Args:
+        path: Output file
+        arrays: Mapping name → 1-D array
+
+    Returns:
+        File size in bytes
+    """
+    header_size = 16 + 56 * len(arrays)
+    offset = -(-header_size // _ALIGN) * _ALIGN
+
+    entries = []
+    for name, arr in arrays.items():
+        arr = np.ascontiguousarray(arr).reshape(-1)
+        entries.append((name, arr, offset))
+        offset += -(-arr.nbytes // _ALIGN) * _ALIGN
+
+    with open(path, 'wb') as f:
+        f.write(_MAGIC)
+        f.write(struct.pack('<Q', len(entries)))
+        for name, arr, off in entries:
+            f.write(name.encode('ascii').ljust(32, b'\0'))
+            f.write(arr.dtype.str.encode('ascii').ljust(8, b'\0'))
+            f.write(struct.pack('<QQ', len(arr), off))
+        for name, arr, off in entries:
+            f.seek(off)
+            f.write(arr.tobytes())
+        f.truncate(offset)
+
+    return offset
+
+
+def array_index(path: str) -> Dict[str, Tuple[np.dtype, int, int]]:
+    """
+    Read the header of a file written by save_arrays().
+
+    Args:
+        path: Input file
+
+    Returns:
+        Mapping name → (dtype, length, byte offset)
+    """
+    with open(path, 'rb') as f:
+        if f.read(8) != _MAGIC:
+            raise ValueError(f"Not an array container file: {path}")
+        count, = struct.unpack('<Q', f.read(8))
+        index = {}
+        for _ in range(count):
+            name = f.read(32).rstrip(b'\0').decode('ascii')
+            dtype = np.dtype(f.read(8).rstrip(b'\0').decode('ascii'))
+            length, off = struct.unpack('<QQ', f.read(16))
+            index[name] = (dtype, length, off)
+    return index
+
+
+def load_arrays(path: str, mmap: bool = True) -> Dict[str, np.ndarray]:
+    """
+    Open a file written by save_arrays().
+
+    Args:
+        path: Input file
+        mmap: Map arrays read-only instead of reading them into memory
+
+    Returns:
+        Mapping name → array
+    """
+    arrays = {}
+    for name, (dtype, length, off) in array_index(path).items():
+        if mmap and length > 0:
+            arrays[name] = np.memmap(path, dtype=dtype, mode='r', offset=off, shape=(length,))
+        else:
+            arrays[name] = np.fromfile(path, dtype=dtype, count=length, offset=off)
+    return arrays
+
+
+def edge_file_to_csr(path: str, chunk_lines: int = 1 << 20,
+                     reader=None) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """
+    Parse an edge-list file into a simple undirected CSR.
+
+    Self-loops and duplicate edges (in either direction) are dropped and raw
+    ids are relabelled 0..n-1 in ascending raw id order.
+
+    Args:
+        path: Edge-list file (plain or .gz)
+        chunk_lines: Lines per streamed chunk
+        reader: Optional block_reader.BlockReader (see iter_edge_chunks)
+
+    Returns:
+        (offsets, neighbors, raw_ids) with raw_ids[v] the original id of v
+    """
+    # Deduplicate (lo, hi) rows: raw ids may use all 64 bits, so they cannot
+    # be packed into one key
+    pairs = []
+    for chunk in iter_edge_chunks(path, chunk_lines, reader):
+        chunk = chunk[chunk[:, 0] != chunk[:, 1]]
+        pairs.append(np.unique(np.sort(chunk, axis=1), axis=0))
+
+    pairs = np.unique(np.concatenate(pairs), axis=0) if pairs else np.zeros((0, 2), dtype=np.int64)
+    lo = pairs[:, 0]
+    hi = pairs[:, 1]
+
+    raw_ids = np.unique(np.concatenate((lo, hi)))
+    edges = np.stack((np.searchsorted(raw_ids, lo), np.searchsorted(raw_ids, hi)), axis=1)
+    offsets, neighbors = edges_to_csr(edges, len(raw_ids))
+    return offsets, neighbors, raw_ids
+
+
+def csr_edge_keys(offsets: np.ndarray, neighbors: np.ndarray,
+                  relabel: np.ndarray = None) -> np.ndarray:
+    """
+    Sorted int64 keys (u << 32 | v, u < v) of the undirected edges of a CSR.
+
+    Args:
+        offsets: CSR offsets
+        neighbors: CSR neighbours
+        relabel: Optional new id of every vertex (must preserve order)
+
+    Returns:
+        Sorted int64 array with one key per edge
+    """
+    n = len(offsets) - 1
+    src = np.repeat(np.arange(n, dtype=np.int64), np.diff(offsets))
+    dst = np.asarray(neighbors, dtype=np.int64)
+    if relabel is not None:
+        src = relabel[src]
+        dst = relabel[dst]
+    upper = src < dst
+    return np.sort(src[upper] << 32 | dst[upper])
@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+"""
+Single-sweep graph statistics over CSR, cached by graph fingerprint
+
+One compiled pass replaces the separate networkx calls (density,
+is_connected, degree sums, number_of_edges, number_of_selfloops) the
+drivers used to make, each a walk over Python objects:
+
+    sweep (prange over v):   degree, self-loop entries, duplicate entries
+    components (prange):     hook-and-compress union of root labels
+    numpy:                   degree histogram, component size histogram
+
+Self-loops are counted from entries u == v (a loop appears twice in v's
+list, as edges_to_csr() adds both directions), multi-edges as the extra
+copies of each vertex pair, loops included. Sorted adjacency lists are
+checked in place; unsorted ones are sorted in a per-vertex copy.
+
+Components: every vertex points to a smaller-or-equal id, starting from
+itself. Each round hooks the root of v under a smaller root label found
+across an edge, then compresses all paths to the roots. Concurrent hooks
+of the same root may overwrite each other; the lost hook is simply found
+again next round, and the loop stops only after a round with no hooks, at
+which point every edge joins equal roots.
+
+Reports are keyed by a blake2b fingerprint of the CSR arrays and kept in
+memory; with a cache directory they are also written as
+{fingerprint}.stats.bin (save_arrays() format), so drivers that reopen a
+cached graph print from the stored report without another sweep.
+"""
+
+import hashlib
+import os
+import time
+import numpy as np
+from numba import njit, prange
+from typing import Dict, Optional
+
+from graph_csr import load_arrays, save_arrays
+
+
+# Integer fields stored in the on-disk report, in this order
+_COUNTS = ('n', 'm', 'self_loops', 'multi_edges', 'components', 'largest_component',
+           'largest_component_edges', 'isolated')
+
+_REPORTS: Dict[str, dict] = {}
+
+
+def csr_fingerprint(offsets: np.ndarray, neighbors: np.ndarray) -> str:
+    """
+    Content hash of a CSR graph.
+
+    Args:
+        offsets: CSR offsets
+        neighbors: CSR neighbours
+
+    Returns:
+        32-character hex digest
+    """
+    h = hashlib.blake2b(digest_size=16)
+    h.update(np.int64(len(offsets) - 1).tobytes())
+    h.update(memoryview(np.ascontiguousarray(offsets, dtype=np.int64)).cast('B'))
+    h.update(memoryview(np.ascontiguousarray(neighbors)).cast('B'))
+    return h.hexdigest()
+
+
+@njit(parallel=True, cache=True)
+def _sweep(offsets: np.ndarray, neighbors: np.ndarray, loop_entries: np.ndarray,
+           duplicates: np.ndarray) -> None:
+    """Per-vertex self-loop entries and extra copies of pairs (v, u ≥ v)."""
+    n = len(offsets) - 1
+    for v in prange(n):
+        lo = offsets[v]
+        hi = offsets[v + 1]
+        loops = 0
+        in_order = True
+        for idx in range(lo, hi):
+            if neighbors[idx] == v:
+                loops += 1
+            if idx > lo and neighbors[idx] < neighbors[idx - 1]:
+                in_order = False
+        loop_entries[v] = loops
+
+        adj = neighbors[lo:hi] if in_order else np.sort(neighbors[lo:hi])
+        extra = 0
+        for i in range(1, len(adj)):
+            if adj[i] == adj[i - 1] and adj[i] > v:
+                extra += 1
+        if loops > 2:
+            extra += loops // 2 - 1
+        duplicates[v] = extra
+
+
+@njit(parallel=True, cache=True)
+def _component_labels(offsets: np.ndarray, neighbors: np.ndarray) -> np.ndarray:
+    """Smallest vertex id of the component of every vertex."""
+    n = len(offsets) - 1
+    parent = np.arange(n)
+
+    hooks = 1
+    while hooks > 0:
+        hooks = 0
+        for v in prange(n):
+            root = parent[v]
+            best = root
+            for idx in range(offsets[v], offsets[v + 1]):
+                label = parent[neighbors[idx]]
+                if label < best:
+                    best = label
+            if best < parent[root]:
+                parent[root] = best
+                hooks += 1
+
+        for v in prange(n):
+            p = parent[v]
+            while parent[p] != p:
+                p = parent[p]
+            parent[v] = p
+
+    return parent
+
+
+def _finish(report: dict) -> dict:
+    """Fill in the fields derived from the stored counts and histograms."""
+    n = report['n']
+    m = report['m']
+    hist = np.asarray(report['degree_histogram'], dtype=np.int64)
+    degree = np.arange(len(hist), dtype=np.float64)
+
+    mean = float((degree * hist).sum() / n) if n > 0 else 0.0
+    second = float((degree ** 2 * hist).sum() / n) if n > 0 else 0.0
+    nonzero = np.flatnonzero(hist)
+
+    report['degree_histogram'] = hist
+    report['component_size_histogram'] = np.asarray(report['component_size_histogram'],
+                                                    dtype=np.int64)
+    report['density'] = 2 * m / (n * (n - 1)) if n > 1 else 0.0
+    report['average_degree'] = mean
+    report['degree_second_moment'] = second
+    report['degree_std'] = float(np.sqrt(max(second - mean * mean, 0.0)))
+    report['max_degree'] = int(nonzero[-1]) if len(nonzero) > 0 else 0
+    report['min_degree'] = int(nonzero[0]) if len(nonzero) > 0 else 0
+    report['connected'] = report['components'] == 1
+    return report
+
+
+def graph_stats(offsets: np.ndarray, neighbors: np.ndarray,
+                cache_dir: Optional[str] = None, verbose: bool = False) -> dict:
+    """
+    Statistics report of a CSR graph (computed once per fingerprint).
+
+    Args:
+        offsets: CSR offsets
+        neighbors: CSR neighbours
+        cache_dir: Also keep the report in {cache_dir}/{fingerprint}.stats.bin
+        verbose: Print the report
+
+    Returns:
+        Dictionary with n, m, density, average_degree, degree_std,
+        degree_second_moment, min_degree, max_degree, degree_histogram,
+        self_loops, multi_edges, components, connected, largest_component,
+        largest_component_edges, isolated, component_size_histogram
+        (index = size), fingerprint and time (0 when served from a cache)
+    """
+    start_time = time.time()
+    fingerprint = csr_fingerprint(offsets, neighbors)
+
+    report = _REPORTS.get(fingerprint)
+    path = os.path.join(cache_dir, f'{fingerprint}.stats.bin') if cache_dir else None
+    if report is None and path is not None and os.path.exists(path):
+        stored = load_arrays(path, mmap=False)
+        report = {key: int(value) for key, value in zip(_COUNTS, stored['counts'])}
+        report['degree_histogram'] = stored['degree_histogram']
+        report['component_size_histogram'] = stored['component_size_histogram']
+        report = _finish(report)
+        report['fingerprint'] = fingerprint
+        _REPORTS[fingerprint] = report
+
+    if report is not None:
+        report = dict(report, time=0.0)
+        if verbose:
+            print_graph_stats(report)
+        return report
+
+    n = len(offsets) - 1
+    degrees = np.diff(offsets)
+    loop_entries = np.zeros(n, dtype=np.int64)
+    duplicates = np.zeros(n, dtype=np.int64)
+    _sweep(offsets, neighbors, loop_entries, duplicates)
+
+    labels = _component_labels(offsets, neighbors)
+    sizes = np.bincount(labels, minlength=n) if n > 0 else np.zeros(0, dtype=np.int64)
+    roots = np.flatnonzero(sizes)
+    largest = int(roots[np.argmax(sizes[roots])]) if n > 0 else -1
+    in_largest = labels == largest
+
+    report = {
+        'n': n,
+        'm': len(neighbors) // 2,
+        'self_loops': int(loop_entries.sum()) // 2,
+        'multi_edges': int(duplicates.sum()),
+        'components': len(roots),
+        'largest_component': int(sizes[largest]) if n > 0 else 0,
+        'largest_component_edges': int(degrees[in_largest].sum()) // 2,
+        'isolated': int(np.count_nonzero(degrees == 0)),
+        'degree_histogram': np.bincount(degrees),
+        'component_size_histogram': np.bincount(sizes[roots]),
+    }
+    report = _finish(report)
+    report['fingerprint'] = fingerprint
+    _REPORTS[fingerprint] = report
+
+    if path is not None:
+        save_arrays(path, {
+            'counts': np.array([report[key] for key in _COUNTS], dtype=np.int64),
+            'degree_histogram': report['degree_histogram'],
+            'component_size_histogram': report['component_size_histogram'],
+        })
+
+    report = dict(report, time=time.time() - start_time)
+    if verbose:
+        print_graph_stats(report)
+    return report
+
+
+def graph_stats_networkx(G, verbose: bool = False) -> dict:
+    """
+    graph_stats() for a networkx graph (self-loops and parallel edges kept).
+    """
+    from graph_csr import networkx_to_csr
+
+    offsets, neighbors, _ = networkx_to_csr(G, keep_self_loops=True)
+    return graph_stats(offsets, neighbors, verbose=verbose)
+
+
+def print_graph_stats(report: dict) -> None:
+    """
+    Print a statistics report.
+
+    Args:
+        report: Dictionary from graph_stats()
+    """
+    n = report['n']
+    print(f"Nodes: {n:,}")
+    print(f"Edges: {report['m']:,}")
+    print(f"Average degree: {report['average_degree']:.2f} "
+          f"(std {report['degree_std']:.2f}, <k²> = {report['degree_second_moment']:.2f})")
+    print(f"Degree range: {report['min_degree']} .. {report['max_degree']}")
+    print(f"Density: {report['density']:.6f}")
+    print(f"Self-loops: {report['self_loops']:,}, multi-edges: {report['multi_edges']:,}")
+    print(f"Connected: {report['connected']}")
+    if not report['connected']:
+        print(f"  Components: {report['components']:,} "
+              f"(largest {report['largest_component']:,} nodes / "
+              f"{report['largest_component_edges']:,} edges, "
+              f"{report['isolated']:,} isolated nodes)")
+    if report['time'] > 0:
+        print(f"  (statistics sweep: {report['time']:.3f} seconds)")
+
+
+if __name__ == "__main__":
+    import sys
+
+    for path in sys.argv[1:]:
+        arrays = load_arrays(path)
+        print(f"\n{'='*70}")
+        print(path)
+        print(f"{'='*70}")
+        graph_stats(arrays['offsets'], arrays['neighbors'],
+                    cache_dir=os.path.dirname(path) or '.', verbose=True)
@@ -8,12 +8,24 @@ Uses igraph's C++ backend for graph operations + NumPy for vectorized computatio
 """
 
 import igraph as ig
+import networkx as nx
 import numpy as np
 import heapq
+import math
 import time
+from collections.abc import Sequence
 from typing import Tuple, List, Optional
 from numba import njit
 
+from graph_csr import igraph_to_csr, networkx_to_csr, view_mask, view_degrees, induced_csr
+from pseudoarboricity import compute_pseudoarboricity
+from h_partition import h_partition
+from approximate_peel import approximate_peel_states
+from sharded_peel import sharded_peel_states
+from prefetch_peel import _bucket_peel_prefetch_csr, _bucket_peel_prefetch_view, PREFETCH_DISTANCE
+from treewidth_dp import exact_alpha_auto, exact_alpha_networkx_auto
+from degree_bounds import capped_top_sums, alpha_upper_bounds
+
 
 class LargeSetArboricityIgraph:
     """
@@ -23,21 +35,36 @@ class LargeSetArboricityIgraph:
         αk(G) = max_{G' ⊆ G, |V(G')| > k} ⌈d̄[G']⌉
     
     where d̄[G'] is the average degree of subgraph G'.
+    
+    Peeling engines (engine flag):
+        'heap'   heapq over igraph neighbour lookups (default)
+        'numba'  compiled bucket-queue peel over CSR arrays, no Python
+                 objects in the loop; for hosts without compiled extensions
+        'prefetch' the numba peel with a software-prefetch pipeline over
+                 neighbour lists (prefetch_peel.py); identical results
     """
     
-    def __init__(self, G: ig.Graph):
-        """Initialize with an igraph Graph."""
+    ENGINES = ('heap', 'numba', 'prefetch')
+    
+    def __init__(self, G: ig.Graph, engine: str = 'heap'):
+        """Initialize with an igraph Graph and a peeling engine."""
+        if engine not in self.ENGINES:
+            raise ValueError(f"Unknown engine: {engine}\n"
+                             f"Available: {list(self.ENGINES)}")
         self.G = G
         self.n = G.vcount()
         self.m = G.ecount()
+        self.engine = engine
+        self._csr = None
     
     @classmethod
-    def from_networkx(cls, G_nx):
+    def from_networkx(cls, G_nx, engine: str = 'heap'):
         """
         Create from NetworkX graph with proper node ID mapping.
         
         Args:
             G_nx: NetworkX Graph
+            engine: Peeling engine ('heap', 'numba' or 'prefetch')
             
         Returns:
             LargeSetArboricityIgraph instance
@@ -56,16 +83,18 @@ class LargeSetArboricityIgraph:
         if edge_list:
             G_ig.add_edges(edge_list)
         
-        return cls(G_ig)
+        return cls(G_ig, engine)
     
     @classmethod
-    def from_edgelist(cls, edges: List[Tuple[int, int]], n: Optional[int] = None):
+    def from_edgelist(cls, edges: List[Tuple[int, int]], n: Optional[int] = None,
+                      engine: str = 'heap'):
         """
         Create from edge list.
         
         Args:
             edges: List of (u, v) tuples
             n: Number of nodes (if None, inferred from edges)
+            engine: Peeling engine ('heap', 'numba' or 'prefetch')
             
         Returns:
             LargeSetArboricityIgraph instance
@@ -77,7 +106,43 @@ class LargeSetArboricityIgraph:
         if edges:
             G.add_edges(edges)
         
-        return cls(G)
+        return cls(G, engine)
+    
+    def to_csr(self) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        CSR arrays of the graph for the Numba engines (built once, then cached).
+
+        Returns:
+            (offsets, neighbors)
+        """
+        if self._csr is None:
+            self._csr = igraph_to_csr(self.G)
+        return self._csr
+    
+    def peel_csr(self, subset=None) -> Tuple[np.ndarray, ...]:
+        """
+        Full minimum-degree peel with the compiled bucket-queue kernel
+        (the prefetching one for engine='prefetch').
+        
+        Args:
+            subset: Optional vertex mask or vertex list; peels the induced
+                    subgraph as a view over the cached CSR (no copy)
+        
+        Returns:
+            (order, degree_at_removal, vertices_at_step, edges_at_step, coreness)
+        """
+        offsets, neighbors = self.to_csr()
+        if self.engine == 'prefetch':
+            if subset is None:
+                return _bucket_peel_prefetch_csr(offsets, neighbors)
+            mask = view_mask(self.n, subset)
+            return _bucket_peel_prefetch_view(offsets, neighbors, mask,
+                                              view_degrees(offsets, neighbors, mask),
+                                              PREFETCH_DISTANCE)
+        if subset is None:
+            return _bucket_peel_csr(offsets, neighbors)
+        mask = view_mask(self.n, subset)
+        return _bucket_peel_view(offsets, neighbors, mask, view_degrees(offsets, neighbors, mask))
     
     def compute_dk(self, k: int, verbose: bool = False) -> int:
         """
@@ -96,6 +161,13 @@ class LargeSetArboricityIgraph:
         if k < 0:
             k = 0
         
+        if self.engine != 'heap':
+            _, _, vertices_at_step, edges_at_step, _ = self.peel_csr()
+            dk_value = int(_compute_dk_from_states(vertices_at_step, edges_at_step, k + 1)[k])
+            if verbose:
+                print(f"d_{k}(G) = {dk_value}")
+            return dk_value
+        
         # Get degree sequence as NumPy array (FAST: O(n) C++ operation)
         degrees = np.array(self.G.degree(), dtype=np.int32)
         
@@ -154,8 +226,8 @@ class LargeSetArboricityIgraph:
         2. Track graph state at each removal step
         3. For each k, find max average degree seen when vertices > k
         
-        This is O(n + m) with the degeneracy ordering, then O(n²) for computing all dk.
-        But the O(n²) part uses NumPy vectorization so it's very fast.
+        The peel is O(m log n) with the heap engine or O(n + m) with the numba
+        engine, then O(n) for computing all dk from the recorded states.
         
         Args:
             verbose: Print progress information
@@ -169,6 +241,16 @@ class LargeSetArboricityIgraph:
             print(f"Computing all d_k values for graph with n={n}, m={self.m}...")
             start_time = time.time()
         
+        if self.engine != 'heap':
+            _, _, vertices_at_step, edges_at_step, _ = self.peel_csr()
+            dk_values = _compute_dk_from_states(vertices_at_step, edges_at_step, n)
+            if verbose:
+                elapsed = time.time() - start_time
+                print(f"✓ Computed all d_k values in {elapsed:.3f} seconds ({self.engine} engine)")
+                print(f"  Degeneracy d_0 = {dk_values[0]}")
+                print(f"  Arboricity α(G) ≈ ⌈d_0/2⌉ = {int(np.ceil(dk_values[0]/2))}")
+            return np.arange(n, dtype=np.int32), dk_values
+        
         # Get degree sequence as NumPy array
         degrees = np.array(self.G.degree(), dtype=np.int32)
         
@@ -228,7 +310,444 @@ class LargeSetArboricityIgraph:
         
         k_values = np.arange(n, dtype=np.int32)
         return k_values, dk_values
+
+    def compute_all_dk_subset(self, subset, compact: Optional[bool] = None,
+                              compact_fraction: float = 0.1,
+                              verbose: bool = True) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Compute dk for ALL k on the subgraph induced by a vertex subset.
+        
+        Uses the numba peel over the cached CSR regardless of engine, so no
+        igraph subgraph is built. Large subsets are peeled as a masked view
+        (masked-out neighbours are skipped during the scans); small ones are
+        first compacted into their own CSR, which then fits in cache.
+        
+        Args:
+            subset: Vertex mask (bool[n]) or vertex ids
+            compact: Force (True) or forbid (False) compaction; by default
+                     compact when |S| ≤ compact_fraction · n
+            compact_fraction: Size threshold for automatic compaction
+            verbose: Print progress information
+            
+        Returns:
+            (k_values, dk_values) for the induced subgraph, k = 0 .. |S|-1
+        """
+        mask = view_mask(self.n, subset)
+        size = int(mask.sum())
+        if compact is None:
+            compact = size <= compact_fraction * self.n
+        
+        if verbose:
+            print(f"Computing all d_k values for induced subgraph |S|={size} of n={self.n} "
+                  f"({'compacted' if compact else 'masked view'})...")
+            start_time = time.time()
+        
+        offsets, neighbors = self.to_csr()
+        if compact:
+            sub_offsets, sub_neighbors = induced_csr(offsets, neighbors, np.flatnonzero(mask))
+            _, _, vertices_at_step, edges_at_step, _ = _bucket_peel_csr(sub_offsets, sub_neighbors)
+        else:
+            _, _, vertices_at_step, edges_at_step, _ = _bucket_peel_view(
+                offsets, neighbors, mask, view_degrees(offsets, neighbors, mask))
+        dk_values = _compute_dk_from_states(vertices_at_step, edges_at_step, size)
+        
+        if verbose:
+            elapsed = time.time() - start_time
+            print(f"✓ Computed all d_k values in {elapsed:.3f} seconds")
+            if size > 0:
+                print(f"  Subset d_0 = {dk_values[0]}, |E(S)| = {edges_at_step[0]}")
+        
+        k_values = np.arange(size, dtype=np.int32)
+        return k_values, dk_values
+
+    def compute_ego_profiles(self, radius: int = 1, vertices=None,
+                             num_threads: Optional[int] = None,
+                             verbose: bool = True) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        d_0 and degeneracy of the r-hop ego network of every vertex.
+        
+        Ego networks are extracted into per-thread scratch CSR buffers and
+        peeled in parallel (see ego_networks.py).
+        
+        Args:
+            radius: Ego network radius (1 or 2)
+            vertices: Ego centres (default: all vertices)
+            num_threads: Worker threads (default: CPU count)
+            verbose: Print progress information
+            
+        Returns:
+            (dk0, degeneracy) int32 arrays of length n (-1 for non-centres)
+        """
+        from ego_networks import ego_network_profiles  # imports this module's kernel
+        
+        offsets, neighbors = self.to_csr()
+        result = ego_network_profiles(offsets, neighbors, radius, vertices,
+                                      num_threads, verbose=verbose)
+        return result['dk0'], result['degeneracy']
+
+    def compute_all_dk_approximate(self, epsilon: float = 0.1, verbose: bool = True,
+                                   subset=None) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        APPROXIMATE: Compute dk(G) for all k from round-synchronous peeling.
+
+        Each round removes every vertex with degree ≤ (1+ε)·d̄ at once, so only
+        O(log n / ε) states are recorded instead of n.
+
+        Args:
+            epsilon: Round threshold slack ε > 0
+            verbose: Print progress information
+            subset: Optional vertex mask or vertex list (induced-subgraph view)
+
+        Returns:
+            (k_values, dk_values) as NumPy arrays
+        """
+        mask = None if subset is None else view_mask(self.n, subset)
+        n = self.n if mask is None else int(mask.sum())
+
+        if verbose:
+            scope = f"n={n}, m={self.m}" if mask is None else f"induced subgraph |S|={n}"
+            print(f"Computing approximate d_k values (ε={epsilon}) for {scope}...")
+            start_time = time.time()
+
+        offsets, neighbors = self.to_csr()
+        vertices_at_round, edges_at_round, _ = approximate_peel_states(offsets, neighbors, epsilon, mask)
+        dk_values = _compute_dk_from_states(vertices_at_round, edges_at_round, n)
+
+        if verbose:
+            elapsed = time.time() - start_time
+            print(f"✓ {len(vertices_at_round) - 1} rounds in {elapsed:.3f} seconds")
+            print(f"  Approximate d_0 = {dk_values[0]}")
+
+        k_values = np.arange(n, dtype=np.int32)
+        return k_values, dk_values
+
+    def compute_all_dk_sharded(self, num_shards: int = 4, epsilon: float = 0.1,
+                               verbose: bool = True) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        SHARDED: Approximate dk(G) profile with vertices split across worker processes.
+
+        Produces the same profile as compute_all_dk_approximate(epsilon);
+        boundary degree decrements are exchanged in per-round batches.
+
+        Args:
+            num_shards: Number of worker processes
+            epsilon: Round threshold slack ε > 0
+            verbose: Print progress information
+
+        Returns:
+            (k_values, dk_values) as NumPy arrays
+        """
+        n = self.n
+
+        if verbose:
+            print(f"Computing sharded d_k values ({num_shards} shards, ε={epsilon}) "
+                  f"for n={n}, m={self.m}...")
+            start_time = time.time()
+
+        offsets, neighbors = self.to_csr()
+        vertices_at_round, edges_at_round, stats = sharded_peel_states(
+            offsets, neighbors, num_shards, epsilon)
+        dk_values = _compute_dk_from_states(vertices_at_round, edges_at_round, n)
+
+        if verbose:
+            elapsed = time.time() - start_time
+            print(f"✓ {stats['rounds']} rounds in {elapsed:.3f} seconds")
+            print(f"  Cross-shard decrements: {stats['cross_shard_decrements']:,}")
+            print(f"  Approximate d_0 = {dk_values[0]}")
+
+        k_values = np.arange(n, dtype=np.int32)
+        return k_values, dk_values
+
+    def compute_all_dk_multiqueue(self, workers: Optional[int] = None, batch: int = 256,
+                                  verbose: bool = True) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        MULTIQUEUE: dk(G) profile of a relaxed-priority parallel peel.
+
+        Worker threads pop approximately-minimum-degree vertices from their
+        own bucket queues; the profile is exact for the order produced, and
+        the rank error of that order is measured (see multiqueue_peel.py).
+
+        Args:
+            workers: Worker threads (default: Numba's thread count)
+            batch: Pops per worker between decrement exchanges
+            verbose: Print progress information
+
+        Returns:
+            (k_values, dk_values) as NumPy arrays
+        """
+        from multiqueue_peel import multiqueue_peel
+
+        if verbose:
+            print(f"Computing MultiQueue d_k values for n={self.n}, m={self.m}...")
+
+        offsets, neighbors = self.to_csr()
+        result = multiqueue_peel(offsets, neighbors, workers, batch=batch, verbose=verbose)
+        k_values = np.arange(self.n, dtype=np.int32)
+        return k_values, result['dk']
+
+    def compute_top_t_dense_subgraphs(self, t: int, k: int = 0,
+                                      verbose: bool = False) -> List[Tuple[np.ndarray, float]]:
+        """
+        Extract the t densest vertex-disjoint witness subgraphs, each with |V| > k.
+
+        Strategy:
+        1. Peel the alive vertices with the compiled bucket queue, as a view
+           (mask) over the current CSR, recording (vertices, edges) before each removal
+        2. The witness is the suffix of the removal order with maximum average degree
+        3. Remove the witness from the mask and decrement degrees of its alive
+           neighbours in place, so the next view needs no degree recount
+        4. Once half the vertices or edges of the current CSR are gone,
+           compact the remainder into its own CSR
+        5. Repeat on the remainder
+
+        The current CSR never holds more than twice the remaining vertices
+        and edges, so extraction i costs O(n_i + m_i) for what is still left;
+        each compaction is paid for by the removals that triggered it.
+        Local ids of a compacted CSR keep the global id order, so ties are
+        broken exactly as in a view over the full graph.
+
+        Args:
+            t: Number of witness sets to extract
+            k: Each witness must have more than k vertices
+            verbose: Print progress information
+
+        Returns:
+            List of (vertex_ids, average_degree) pairs, densest first
+        """
+        if k < 0:
+            k = 0
+
+        offsets, neighbors = self.to_csr()
+        ids = np.arange(self.n, dtype=np.int32)  # Local id → global id
+        degrees = np.diff(offsets)
+        alive = np.ones(self.n, dtype=bool)
+        vertices_alive = self.n
+        edges_alive = self.m
+
+        witnesses = []
+
+        while len(witnesses) < t and vertices_alive > k and edges_alive > 0:
+            if 2 * vertices_alive < len(ids) or 4 * edges_alive < len(neighbors):
+                offsets, neighbors, rest = _compact_alive(offsets, neighbors, alive)
+                ids = ids[rest]
+                degrees = degrees[rest]
+                alive = np.ones(len(rest), dtype=bool)
+
+            order, _, vertices_at_step, edges_at_step, _ = _bucket_peel_view(
+                offsets, neighbors, alive, degrees.copy())
+
+            # Densest suffix with > k vertices (first maximum, as the peel goes)
+            steps = int(np.count_nonzero(vertices_at_step > k))
+            avg_degree = 2.0 * edges_at_step[:steps] / vertices_at_step[:steps]
+            best_step = int(np.argmax(avg_degree))
+            best_avg = float(avg_degree[best_step])
+            if best_avg <= 0.0:
+                break
+
+            witness = order[best_step:]
+            best_edges = int(edges_at_step[best_step])
+            witnesses.append((ids[witness], best_avg))
+
+            cut_edges = _detach_vertices(offsets, neighbors, witness, alive, degrees)
+            vertices_alive -= len(witness)
+            edges_alive -= best_edges + cut_edges
+
+            if verbose:
+                print(f"  Witness {len(witnesses)}: |V|={len(witness)}, "
+                      f"|E|={best_edges}, d̄={best_avg:.3f}")
+
+        return witnesses
+
+    def degeneracy_order(self) -> np.ndarray:
+        """
+        Compute the minimum-degree removal order (degeneracy ordering).
+
+        Returns:
+            Vertex ids in the order they are removed
+        """
+        if self.engine != 'heap':
+            return self.peel_csr()[0]
+        
+        n = self.n
+        degrees = np.array(self.G.degree(), dtype=np.int32)
+        adj = self.G.get_adjlist()
+
+        heap = [(degrees[v], v) for v in range(n)]
+        heapq.heapify(heap)
+
+        removed = np.zeros(n, dtype=bool)
+        order = np.empty(n, dtype=np.int32)
+        step = 0
+
+        while heap:
+            deg, v = heapq.heappop(heap)
+            if removed[v]:
+                continue
+
+            removed[v] = True
+            order[step] = v
+            step += 1
+
+            for u in adj[v]:
+                if not removed[u]:
+                    degrees[u] -= 1
+                    heapq.heappush(heap, (degrees[u], u))
+
+        return order
+
+    def compute_coreness(self) -> np.ndarray:
+        """
+        Core number of every vertex.
+        
+        Returns:
+            int32 array of core numbers
+        """
+        if self.engine != 'heap':
+            return self.peel_csr()[4]
+        return np.array(self.G.coreness(), dtype=np.int32)
+
+    def compute_pseudoarboricity(self, verbose: bool = False) -> Tuple[int, np.ndarray]:
+        """
+        Compute pseudoarboricity p(G) = min over orientations of max out-degree.
+
+        Starts from the degeneracy orientation and lowers the maximum out-degree
+        with blocking-flow path reversals (see pseudoarboricity.py).
+
+        Args:
+            verbose: Print progress information
+
+        Returns:
+            (pseudoarboricity, oriented_edges) with oriented_edges[i] = (tail, head)
+        """
+        if verbose:
+            print(f"Computing pseudoarboricity for graph with n={self.n}, m={self.m}...")
+            start_time = time.time()
+
+        edges = np.array(self.G.get_edgelist(), dtype=np.int64).reshape(-1, 2)
+        p, oriented = compute_pseudoarboricity(edges, self.n, self.degeneracy_order())
+
+        if verbose:
+            elapsed = time.time() - start_time
+            print(f"✓ Pseudoarboricity p(G) = {p} in {elapsed:.3f} seconds")
+            print(f"  Arboricity: {p} ≤ α(G) ≤ {p + 1}")
+
+        return p, oriented
+
+    def compute_clustering(self, verbose: bool = False) -> dict:
+        """
+        Triangle counts and clustering coefficients over the degeneracy
+        orientation (see triangles.py), in O(m · d₀).
+
+        Args:
+            verbose: Print a summary
+
+        Returns:
+            Dictionary with triangles, local_clustering, average_clustering,
+            transitivity, total_triangles and time
+        """
+        from triangles import clustering  # imports this module's kernel
+
+        offsets, neighbors = self.to_csr()
+        return clustering(offsets, neighbors, self.degeneracy_order(), verbose=verbose)
+
+    def compute_h_partition(self, epsilon: float = 0.1, alpha: Optional[int] = None,
+                            verbose: bool = False) -> dict:
+        """
+        Barenboim–Elkin H-partition: O(log n) rounds of parallel frontier peeling.
+
+        Args:
+            epsilon: Slack ε in the removal threshold (2+ε)·α
+            alpha: Arboricity guess (default: Nash-Williams lower bound, doubled as needed)
+            verbose: Print progress information
+
+        Returns:
+            Dictionary with per-vertex layers and an arboricity upper bound
+        """
+        if verbose:
+            print(f"Computing H-partition (ε={epsilon}) for n={self.n}, m={self.m}...")
+            start_time = time.time()
+
+        offsets, neighbors = self.to_csr()
+        result = h_partition(offsets, neighbors, epsilon, alpha)
+
+        if verbose:
+            elapsed = time.time() - start_time
+            print(f"✓ {result['num_layers']} layers in {elapsed:.3f} seconds")
+            print(f"  Threshold (2+ε)·α = {result['threshold']}")
+            print(f"  Arboricity α(G) ≤ {result['arboricity_estimate']}")
+
+        return result
+
+    def compute_alpha_k_exact_all(self, max_width: int = 10,
+                                  verbose: bool = True) -> Tuple[np.ndarray, Optional[np.ndarray]]:
+        """
+        EXACT: αk(G) for all k, where an exact solver applies.
+        
+        Tree-decomposition DP when the min-fill width is at most max_width
+        (any n), otherwise bitset branch and bound for n ≤ 512.
+        
+        Args:
+            max_width: Largest decomposition width for the DP
+            verbose: Print progress information
+            
+        Returns:
+            (k_values, alpha_values); alpha_values is None if neither solver applies
+        """
+        if verbose:
+            print(f"Computing exact α_k values for n={self.n}, m={self.m}...")
+            start_time = time.time()
+        
+        offsets, neighbors = self.to_csr()
+        alpha_values, method = exact_alpha_auto(offsets, neighbors, max_width)
+        
+        if verbose:
+            elapsed = time.time() - start_time
+            if alpha_values is None:
+                print(f"✗ No exact solver applies (width > {max_width}, n > 512 or search budget exhausted)")
+            else:
+                print(f"✓ Exact α_k via {method} solver in {elapsed:.3f} seconds")
+                if self.n > 0:
+                    print(f"  α_0 = {alpha_values[0]}")
+        
+        k_values = np.arange(self.n, dtype=np.int32)
+        return k_values, alpha_values
     
+    def compute_bounds_anytime(self, target: str = 'alpha', tolerance: int = 0, ks=None,
+                               callback=None, verbose: bool = True, **options) -> dict:
+        """
+        ANYTIME: Progressive [lower, upper] intervals on dk and αk for every k.
+
+        Stages run from cheapest to most expensive (degree sequence, edge
+        sample, approximate peel, exact peel, Greedy++, exact solvers) and
+        stop once the watched interval is within tolerance.
+
+        Args:
+            target: 'alpha' or 'dk', the interval the stopping rule watches
+            tolerance: Stop once upper - lower ≤ tolerance for every watched k
+            ks: k values to watch (default: all)
+            callback: Called with every published snapshot
+            verbose: Print one line per stage
+            **options: Further AnytimeBounds parameters
+
+        Returns:
+            Last snapshot (dk_lower, dk_upper, alpha_lower, alpha_upper, stage, ...)
+        """
+        from anytime_bounds import AnytimeBounds, print_snapshot  # imports this module's kernel
+
+        if verbose:
+            print(f"Computing anytime bounds ({target}, tolerance {tolerance}) "
+                  f"for n={self.n}, m={self.m}...")
+
+        def publish(snapshot: dict) -> None:
+            if verbose:
+                print_snapshot(snapshot)
+            if callback is not None:
+                callback(snapshot)
+
+        offsets, neighbors = self.to_csr()
+        driver = AnytimeBounds(offsets, neighbors, ks, target, tolerance, publish, **options)
+        return driver.run()
+
     def compute_arboricity_bound(self) -> int:
         """
         Compute upper bound on arboricity: α(G) ≤ ⌈degeneracy/2⌉
@@ -280,6 +799,223 @@ class LargeSetArboricityIgraph:
         }
 
 
+class _RemovalSequence(Sequence):
+    """Lazy (vertex, degree at removal) view of the first steps of a shared peel."""
+
+    def __init__(self, nodes: list, order: np.ndarray, degree_at_removal: np.ndarray, steps: int):
+        self._nodes = nodes
+        self._order = order
+        self._degrees = degree_at_removal
+        self._steps = steps
+
+    def __len__(self) -> int:
+        return self._steps
+
+    def __getitem__(self, i):
+        if isinstance(i, slice):
+            return [self[j] for j in range(*i.indices(self._steps))]
+        if i < 0:
+            i += self._steps
+        if not 0 <= i < self._steps:
+            raise IndexError("removal step out of range")
+        return self._nodes[self._order[i]], int(self._degrees[i])
+
+
+class LargeSetArboricity:
+    """
+    NetworkX front end of the modified degeneracy algorithm.
+    
+    The modified degeneracy algorithm removes n-k vertices, minimum degree
+    first, and reports dk(G) = max degree at removal over those steps. If the
+    maximum is reached at step i by vertex v, the witness
+        H = {v} ∪ {vertices removed after step i}
+    has |V(H)| > k and minimum degree ≥ dk(G), hence dk(G) ≤ αk(G); the
+    notes also show αk(G) ≤ 2·dk(G).
+    
+    One compiled bucket-queue peel is shared by all k: dk(G) is a prefix
+    maximum of the removal degrees and the witness is a suffix of the
+    removal order, so every query after the first is O(1) (O(|H|) to build H).
+    Exact αk comes from the bitset branch and bound (n ≤ 512) or the
+    tree-decomposition DP (low treewidth, any n).
+    """
+    
+    def __init__(self, G: nx.Graph):
+        """Initialize with a NetworkX graph (any node labels)."""
+        self.G = G
+        self.n = G.number_of_nodes()
+        self.m = G.number_of_edges()
+        self._peel = None           # (nodes, order, degree_at_removal, prefix max, argmax)
+        self._exact = None          # (alpha, witnesses or None) or False if unavailable
+    
+    @staticmethod
+    def average_degree(H: nx.Graph) -> float:
+        """Average degree d̄[H] = 2|E(H)| / |V(H)| (0 for the empty graph)."""
+        n = H.number_of_nodes()
+        return 2 * H.number_of_edges() / n if n > 0 else 0.0
+    
+    def _shared_peel(self):
+        """Peel once; prefix maxima of the removal degrees answer every k."""
+        if self._peel is None:
+            offsets, neighbors, nodes = networkx_to_csr(self.G)
+            order, degree_at_removal, _, _, _ = _bucket_peel_csr(offsets, neighbors)
+            prefix_max = np.maximum.accumulate(degree_at_removal) if self.n > 0 \
+                else np.zeros(0, dtype=np.int32)
+            # Step of the first maximum within every prefix
+            steps = np.arange(self.n)
+            new_max = np.ones(self.n, dtype=bool)
+            new_max[1:] = prefix_max[1:] > prefix_max[:-1]
+            argmax = np.maximum.accumulate(np.where(new_max, steps, 0))
+            self._peel = (nodes, order, degree_at_removal, prefix_max, argmax)
+        return self._peel
+    
+    def modified_degeneracy_algorithm(self, k: int) -> Tuple[int, Sequence]:
+        """
+        Modified degeneracy algorithm: remove n-k vertices, minimum degree first.
+        
+        Args:
+            k: Parameter (size of large set)
+            
+        Returns:
+            (dk_value, removal_seq) with removal_seq[i] = (vertex, degree at
+            removal) for the n-k steps
+        """
+        nodes, order, degree_at_removal, prefix_max, _ = self._shared_peel()
+        steps = self.n - max(k, 0)
+        if steps <= 0:
+            return 0, []
+        return int(prefix_max[steps - 1]), _RemovalSequence(nodes, order, degree_at_removal, steps)
+    
+    def compute_all_dk(self) -> np.ndarray:
+        """dk(G) of the modified degeneracy algorithm for k = 0 .. n-1."""
+        prefix_max = self._shared_peel()[3]
+        return prefix_max[::-1].astype(np.int64)
+    
+    def witness_vertices(self, k: int) -> list:
+        """
+        Vertices of the witness H for dk(G): the peel suffix from the step
+        where the maximum removal degree among the first n-k steps occurs.
+        """
+        nodes, order, _, _, argmax = self._shared_peel()
+        steps = self.n - max(k, 0)
+        if steps <= 0:
+            return []
+        return [nodes[v] for v in order[argmax[steps - 1]:]]
+    
+    def construct_witness_subgraph(self, k: int) -> nx.Graph:
+        """
+        Witness subgraph H with |V(H)| > k and minimum degree ≥ dk(G).
+        
+        Args:
+            k: Parameter (size of large set)
+            
+        Returns:
+            Induced subgraph G[H] (a copy)
+        """
+        return self.G.subgraph(self.witness_vertices(k)).copy()
+    
+    def _exact_profile(self, max_width: int = 10):
+        """Exact αk for all k with witnesses when available (cached)."""
+        if self._exact is None:
+            alpha, witnesses, _ = exact_alpha_networkx_auto(self.G, max_width)
+            self._exact = (alpha, witnesses) if alpha is not None else False
+        return self._exact
+    
+    def compute_alpha_k_exact(self, k: int) -> Tuple[Optional[int], Optional[nx.Graph]]:
+        """
+        Exact αk(G) = max over subgraphs with |V| > k of ⌈d̄⌉.
+        
+        The profile for all k is computed once by the bitset branch and bound
+        (n ≤ 512) or the tree-decomposition DP (heuristic width ≤ 10).
+        
+        Args:
+            k: Parameter
+            
+        Returns:
+            (alpha_k_value, best_subgraph); best_subgraph is None for the DP,
+            both are None if no exact solver applies
+        """
+        if k < 0:
+            raise ValueError(f"k must be non-negative (got k={k})")
+        if k >= self.n:
+            return 0, None
+        profile = self._exact_profile()
+        if profile is False:
+            return None, None
+        alpha, witnesses = profile
+        best = self.G.subgraph(witnesses[k]).copy() if witnesses is not None else None
+        return int(alpha[k]), best
+    
+    def verify_approximation_bounds(self, ks=None) -> dict:
+        """
+        Check dk(G) ≤ αk(G) ≤ 2·dk(G) for many k at once.
+        
+        With an exact profile both sides are checked exactly. Otherwise αk is
+        bounded above by orienting every edge towards the later-removed
+        endpoint (e(S) ≤ Σ_{v∈S} min(degree at removal, |S|-1)), which
+        certifies the upper bound wherever that bound is ≤ 2·dk(G).
+        
+        Args:
+            ks: k values (default: 0 .. n-1)
+            
+        Returns:
+            Dictionary of arrays over ks: dk, alpha_k (-1 if unknown),
+            alpha_k_upper, lower_bound_holds, upper_bound_holds (certified),
+            ratio (nan if unknown), and exact (bool)
+        """
+        ks = np.arange(self.n) if ks is None else np.asarray(ks, dtype=np.int64)
+        ks = np.clip(ks, 0, max(self.n - 1, 0))
+        dk_all = self.compute_all_dk()
+        dk = dk_all[ks] if self.n > 0 else np.zeros(len(ks), dtype=np.int64)
+        
+        profile = self._exact_profile() if self.n > 0 else False
+        if profile is not False:
+            alpha = np.asarray(profile[0], dtype=np.int64)[ks]
+            upper = alpha
+        else:
+            alpha = np.full(len(ks), -1, dtype=np.int64)
+            degree_at_removal = self._shared_peel()[2]
+            s = np.arange(1, self.n + 1, dtype=np.int64)
+            max_edges = np.minimum(np.minimum(capped_top_sums(degree_at_removal), self.m),
+                                   s * (s - 1) // 2)
+            upper = alpha_upper_bounds(max_edges)[ks] if self.n > 0 else alpha
+        
+        exact = profile is not False
+        with np.errstate(divide='ignore', invalid='ignore'):
+            ratio = np.where(dk > 0, alpha / np.maximum(dk, 1), np.inf) if exact \
+                else np.full(len(ks), np.nan)
+        return {
+            'k': ks,
+            'dk': dk,
+            'alpha_k': alpha,
+            'alpha_k_upper': upper,
+            'lower_bound_holds': (dk <= alpha) if exact else np.ones(len(ks), dtype=bool),
+            'upper_bound_holds': upper <= 2 * dk,
+            'ratio': ratio,
+            'exact': exact
+        }
+    
+    def verify_approximation_bound(self, k: int) -> dict:
+        """
+        Verify dk(G) ≤ αk(G) ≤ 2·dk(G) for one k.
+        
+        Returns:
+            Dictionary with k, dk_G, alpha_k (int, or 'N/A' if no exact solver
+            applies), alpha_k_upper, lower_bound_holds, upper_bound_holds and
+            approximation_ratio
+        """
+        batch = self.verify_approximation_bounds([k])
+        exact = batch['exact']
+        return {
+            'k': k,
+            'dk_G': int(batch['dk'][0]),
+            'alpha_k': int(batch['alpha_k'][0]) if exact else 'N/A',
+            'alpha_k_upper': int(batch['alpha_k_upper'][0]),
+            'lower_bound_holds': bool(batch['lower_bound_holds'][0]),
+            'upper_bound_holds': bool(batch['upper_bound_holds'][0]),
+            'approximation_ratio': float(batch['ratio'][0]) if exact else None
+        }
+
+
 @njit
 def _compute_dk_from_states(vertices_at_step: np.ndarray, 
                             edges_at_step: np.ndarray,
@@ -293,7 +1029,7 @@ def _compute_dk_from_states(vertices_at_step: np.ndarray,
              ceil(2 * edges / vertices)
     
     Args:
-        vertices_at_step: Array of vertex counts at each step
+        vertices_at_step: Array of vertex counts at each step (non-increasing)
         edges_at_step: Array of edge counts at each step
         n: Total number of vertices
         
@@ -303,24 +1039,254 @@ def _compute_dk_from_states(vertices_at_step: np.ndarray,
     num_steps = len(vertices_at_step)
     dk_values = np.zeros(n, dtype=np.int32)
     
-    for k in range(n):
-        max_avg_degree = 0.0
-        
-        # Find max average degree among steps where vertices > k
-        for step in range(num_steps):
+    # Vertex counts never increase along the peel, so the steps with
+    # vertices > k form a prefix that grows as k decreases: one sweep
+    # with a running maximum is enough (O(n + steps) instead of O(n·steps))
+    max_avg_degree = 0.0
+    step = 0
+    
+    for k in range(n - 1, -1, -1):
+        while step < num_steps and vertices_at_step[step] > k:
             vertices = vertices_at_step[step]
-            edges = edges_at_step[step]
-            
-            if vertices > k and vertices > 0:
-                avg_degree = (2.0 * edges) / vertices
+            if vertices > 0:
+                avg_degree = (2.0 * edges_at_step[step]) / vertices
                 if avg_degree > max_avg_degree:
                     max_avg_degree = avg_degree
+            step += 1
         
         dk_values[k] = int(np.ceil(max_avg_degree))
     
     return dk_values
 
 
+@njit(cache=True)
+def _bucket_peel_csr(offsets: np.ndarray, neighbors: np.ndarray):
+    """
+    Minimum-degree peel of a full CSR graph (see _bucket_peel_view).
+    
+    Returns:
+        (order, degree_at_removal, vertices_at_step, edges_at_step, coreness)
+    """
+    n = len(offsets) - 1
+    degrees = np.empty(n, dtype=np.int64)
+    for v in range(n):
+        degrees[v] = offsets[v + 1] - offsets[v]
+    return _bucket_peel_view(offsets, neighbors, np.ones(n, dtype=np.bool_), degrees)
+
+
+@njit(cache=True)
+def _detach_vertices(offsets: np.ndarray, neighbors: np.ndarray, vertices: np.ndarray,
+                     alive: np.ndarray, degrees: np.ndarray) -> int:
+    """
+    Remove vertices from the alive mask and decrement the degrees of their
+    alive neighbours; returns the number of edges cut to the rest.
+    """
+    for v in vertices:
+        alive[v] = False
+    cut = 0
+    for v in vertices:
+        for idx in range(offsets[v], offsets[v + 1]):
+            u = neighbors[idx]
+            if alive[u]:
+                degrees[u] -= 1
+                cut += 1
+    return cut
+
+
+@njit(cache=True)
+def _compact_alive(offsets: np.ndarray, neighbors: np.ndarray, alive: np.ndarray):
+    """
+    Compact the induced subgraph on the alive vertices into its own CSR.
+    Local ids follow global id order; returns (offsets, neighbors, alive ids).
+    """
+    n = len(offsets) - 1
+    local = np.full(n, -1, dtype=np.int64)
+    count = 0
+    for v in range(n):
+        if alive[v]:
+            local[v] = count
+            count += 1
+    rest = np.empty(count, dtype=np.int64)
+    sub_offsets = np.zeros(count + 1, dtype=np.int64)
+    for v in range(n):
+        if alive[v]:
+            kept = 0
+            for idx in range(offsets[v], offsets[v + 1]):
+                if alive[neighbors[idx]]:
+                    kept += 1
+            rest[local[v]] = v
+            sub_offsets[local[v] + 1] = sub_offsets[local[v]] + kept
+    sub_neighbors = np.empty(sub_offsets[count], dtype=np.int32)
+    pos = 0
+    for v in range(n):
+        if alive[v]:
+            for idx in range(offsets[v], offsets[v + 1]):
+                u = neighbors[idx]
+                if alive[u]:
+                    sub_neighbors[pos] = local[u]
+                    pos += 1
+    return sub_offsets, sub_neighbors, rest
+
+
+@njit(cache=True)
+def _bucket_peel_view(offsets: np.ndarray, neighbors: np.ndarray,
+                      mask: np.ndarray, degrees: np.ndarray):
+    """
+    Minimum-degree peel over CSR arrays with a bucket queue.
+    Compiled with Numba, no Python objects in the loop.
+    
+    Buckets are doubly linked lists indexed by current degree. After removing
+    a vertex of degree d no remaining vertex has degree below d-1, so the
+    scan pointer only steps back by one: O(n + m) overall.
+    
+    Only the induced subgraph on mask is peeled: masked-out vertices start
+    out as removed, so neighbour scans skip them.
+    
+    Args:
+        offsets: CSR offsets (int64[n+1])
+        neighbors: CSR neighbours (int32[2m])
+        mask: Vertices of the view (bool[n])
+        degrees: Degrees inside the view (int64[n], modified in place)
+        
+    Returns:
+        (order, degree_at_removal, vertices_at_step, edges_at_step, coreness)
+        with states recorded before each removal, as in compute_all_dk_optimized;
+        order holds full-graph ids and coreness is -1 outside the view
+    """
+    n = len(offsets) - 1
+    n_view = 0
+    max_degree = 0
+    degree_sum = 0
+    for v in range(n):
+        if mask[v]:
+            n_view += 1
+            degree_sum += degrees[v]
+            if degrees[v] > max_degree:
+                max_degree = degrees[v]
+    
+    # Bucket lists: head[d] -> first vertex, nxt/prv links (-1 = none)
+    head = np.full(max_degree + 1, -1, dtype=np.int64)
+    nxt = np.full(n, -1, dtype=np.int64)
+    prv = np.full(n, -1, dtype=np.int64)
+    for v in range(n - 1, -1, -1):
+        if not mask[v]:
+            continue
+        d = degrees[v]
+        nxt[v] = head[d]
+        if head[d] >= 0:
+            prv[head[d]] = v
+        head[d] = v
+    
+    removed = ~mask
+    order = np.empty(n_view, dtype=np.int32)
+    degree_at_removal = np.empty(n_view, dtype=np.int32)
+    vertices_at_step = np.empty(n_view, dtype=np.int32)
+    edges_at_step = np.empty(n_view, dtype=np.int32)
+    coreness = np.full(n, -1, dtype=np.int32)
+    
+    edges_remaining = degree_sum // 2
+    core = 0
+    d = 0
+    
+    for step in range(n_view):
+        while head[d] < 0:
+            d += 1
+        
+        # Pop the head of the lowest non-empty bucket
+        v = head[d]
+        head[d] = nxt[v]
+        if nxt[v] >= 0:
+            prv[nxt[v]] = -1
+        
+        vertices_at_step[step] = n_view - step
+        edges_at_step[step] = edges_remaining
+        
+        removed[v] = True
+        order[step] = v
+        degree_at_removal[step] = d
+        if d > core:
+            core = d
+        coreness[v] = core
+        edges_remaining -= d
+        
+        # Move every remaining neighbour one bucket down
+        for idx in range(offsets[v], offsets[v + 1]):
+            u = neighbors[idx]
+            if removed[u]:
+                continue
+            du = degrees[u]
+            if prv[u] >= 0:
+                nxt[prv[u]] = nxt[u]
+            else:
+                head[du] = nxt[u]
+            if nxt[u] >= 0:
+                prv[nxt[u]] = prv[u]
+            
+            du -= 1
+            degrees[u] = du
+            prv[u] = -1
+            nxt[u] = head[du]
+            if head[du] >= 0:
+                prv[head[du]] = u
+            head[du] = u
+        
+        if d > 0:
+            d -= 1
+    
+    return order, degree_at_removal, vertices_at_step, edges_at_step, coreness
+
+
+def demonstrate_algorithm(G: nx.Graph, k: int, graph_name: str = "Graph") -> dict:
+    """
+    Walk through the modified degeneracy algorithm, the witness and the
+    approximation bounds on one graph.
+    
+    Args:
+        G: NetworkX graph
+        k: Parameter (size of large set)
+        graph_name: Name for display
+        
+    Returns:
+        verify_approximation_bound(k) dictionary plus the witness size
+    """
+    print(f"\n{'='*70}")
+    print(f"ALGORITHM DEMONSTRATION: {graph_name}")
+    print(f"{'='*70}")
+    lsa = LargeSetArboricity(G)
+    print(f"n = {lsa.n:,}, m = {lsa.m:,}, k = {k}")
+    print(f"Average degree d̄[G] = {lsa.average_degree(G):.3f}")
+    
+    dk_G, removal_seq = lsa.modified_degeneracy_algorithm(k)
+    print(f"\nModified degeneracy algorithm ({len(removal_seq)} removals):")
+    shown = min(len(removal_seq), 10)
+    for i in range(shown):
+        v, d = removal_seq[i]
+        print(f"  step {i + 1:>3}: remove {v} (degree {d})")
+    if len(removal_seq) > shown:
+        print(f"  ... {len(removal_seq) - shown} more")
+    print(f"  dk(G) = {dk_G}")
+    
+    H = lsa.construct_witness_subgraph(k)
+    min_degree = min((d for _, d in H.degree()), default=0)
+    print(f"\nWitness H: |V(H)| = {H.number_of_nodes()}, |E(H)| = {H.number_of_edges()}")
+    print(f"  |V(H)| > k: {'✓' if H.number_of_nodes() > k else '✗'}")
+    print(f"  min degree {min_degree} ≥ dk(G) = {dk_G}: {'✓' if min_degree >= dk_G else '✗'}")
+    print(f"  ⌈d̄[H]⌉ = {math.ceil(lsa.average_degree(H))}")
+    
+    results = lsa.verify_approximation_bound(k)
+    if isinstance(results['alpha_k'], int):
+        print(f"\nExact αk(G) = {results['alpha_k']}")
+        print(f"  dk(G) ≤ αk(G):   {'✓' if results['lower_bound_holds'] else '✗'}")
+        print(f"  αk(G) ≤ 2·dk(G): {'✓' if results['upper_bound_holds'] else '✗'}")
+        print(f"  Approximation ratio: {results['approximation_ratio']:.3f}")
+    else:
+        print(f"\nNo exact solver applies; αk(G) ≤ {results['alpha_k_upper']} (orientation bound)")
+        print(f"  αk(G) ≤ 2·dk(G) certified: {'✓' if results['upper_bound_holds'] else 'unknown'}")
+    
+    results['witness_size'] = H.number_of_nodes()
+    return results
+
+
 def main():
     """Example usage and testing"""
     print("Large-Set-Arboricity (igraph + Numba implementation)\n")
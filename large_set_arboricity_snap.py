@@ -12,10 +12,11 @@ Key optimizations:
 import networkx as nx
 import math
 from typing import Tuple, List, Optional
-from itertools import combinations
 import heapq
 import time
 
+from treewidth_dp import exact_alpha_networkx_auto
+
 
 class LargeSetArboricityOptimized:
     """
@@ -33,6 +34,7 @@ class LargeSetArboricityOptimized:
         self.n = G.number_of_nodes()
         # Cache adjacency for faster access
         self.adj = {v: set(G.neighbors(v)) for v in G.nodes()}
+        self._exact_profile = None  # (alpha, witnesses) from the exact solvers
     
     def modified_degeneracy_algorithm_optimized(self, k: int) -> Tuple[int, List[int]]:
         """
@@ -139,35 +141,35 @@ class LargeSetArboricityOptimized:
         
         return dk_value, removal_order
     
-    def compute_alpha_k_exact(self, k: int) -> Tuple[int, Optional[nx.Graph]]:
-        """
-        Compute exact αk(G) by checking all subgraphs with |V| > k
-        WARNING: Exponential time! Only works for small graphs (n ≤ 15)
+    def compute_alpha_k_exact(self, k: int) -> Tuple[Optional[int], Optional[nx.Graph]]:
         """
-        n = self.n
-        if n <= k:
-            return 0, None
+        Compute exact αk(G) over all subgraphs with |V| > k
+        WARNING: Exponential time in the worst case!
         
-        if n > 15:
-            print(f"Warning: Graph too large (n={n}) for exact αk computation")
-            return None, None
+        The profile for all k is computed once by the shared dispatch in
+        treewidth_dp.exact_alpha_networkx_auto(): bitset branch and bound
+        for n ≤ 512, tree-decomposition DP (no witness subgraph) for larger
+        graphs or when the search budget runs out.
         
-        nodes = list(self.G.nodes())
-        max_alpha = 0
-        best_subgraph = None
+        Args:
+            k: Parameter (k ≥ 0)
         
-        # Check all subsets of size > k
-        for size in range(k + 1, n + 1):
-            for subset in combinations(nodes, size):
-                subgraph = self.G.subgraph(subset)
-                if subgraph.number_of_nodes() > 0 and subgraph.number_of_edges() > 0:
-                    avg_deg = 2 * subgraph.number_of_edges() / subgraph.number_of_nodes()
-                    alpha_val = math.ceil(avg_deg)
-                    if alpha_val > max_alpha:
-                        max_alpha = alpha_val
-                        best_subgraph = subgraph.copy()
+        Returns:
+            (alpha_k_value, best_subgraph); both None if no exact solver applies
+        """
+        if k < 0:
+            raise ValueError(f"k must be non-negative (got k={k})")
+        if self.n <= k:
+            return 0, None
         
-        return max_alpha, best_subgraph
+        if self._exact_profile is None:
+            self._exact_profile = exact_alpha_networkx_auto(self.G)[:2]
+        alpha, witnesses = self._exact_profile
+        if alpha is None:
+            print(f"Warning: no exact αk solver applies (n={self.n})")
+            return None, None
+        best = self.G.subgraph(witnesses[k]).copy() if witnesses is not None else None
+        return int(alpha[k]), best
     
     def verify_approximation(self, k: int, use_optimized: bool = True) -> dict:
         """
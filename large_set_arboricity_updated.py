@@ -8,7 +8,8 @@ import networkx as nx
 import math
 import matplotlib.pyplot as plt
 from typing import Tuple, List, Optional
-from itertools import combinations
+
+from treewidth_dp import exact_alpha_networkx_auto
 
 
 class LargeSetArboricity:
@@ -25,6 +26,7 @@ class LargeSetArboricity:
         """Initialize with a NetworkX graph"""
         self.G = G.copy()
         self.n = G.number_of_nodes()
+        self._exact_profile = None  # (alpha, witnesses) from the exact solvers
     
     def modified_degeneracy_algorithm(self, k: int) -> Tuple[int, List[int]]:
         """
@@ -134,41 +136,35 @@ class LargeSetArboricity:
         
         return max_alpha, best_subgraph
     
-    def compute_alpha_k_exact(self, k: int) -> Tuple[int, Optional[nx.Graph]]:
+    def compute_alpha_k_exact(self, k: int) -> Tuple[Optional[int], Optional[nx.Graph]]:
         """
-        Compute exact αk(G) by checking all subgraphs with |V| > k
-        WARNING: Exponential time! Only works for small graphs (n ≤ 15)
+        Compute exact αk(G) over all subgraphs with |V| > k
+        WARNING: Exponential time in the worst case!
+        
+        The profile for all k is computed once by the shared dispatch in
+        treewidth_dp.exact_alpha_networkx_auto(): bitset branch and bound
+        for n ≤ 512, tree-decomposition DP (no witness subgraph) for larger
+        graphs or when the search budget runs out.
         
         Args:
-            k: Parameter
+            k: Parameter (k ≥ 0)
         
         Returns:
-            (alpha_k_value, best_subgraph)
+            (alpha_k_value, best_subgraph); both None if no exact solver applies
         """
-        n = self.n
-        if n <= k:
+        if k < 0:
+            raise ValueError(f"k must be non-negative (got k={k})")
+        if self.n <= k:
             return 0, None
         
-        if n > 15:
-            print(f"Warning: Graph too large (n={n}) for exact αk computation")
+        if self._exact_profile is None:
+            self._exact_profile = exact_alpha_networkx_auto(self.G)[:2]
+        alpha, witnesses = self._exact_profile
+        if alpha is None:
+            print(f"Warning: no exact αk solver applies (n={self.n})")
             return None, None
-        
-        nodes = list(self.G.nodes())
-        max_alpha = 0
-        best_subgraph = None
-        
-        # Check all subsets of size > k
-        for size in range(k + 1, n + 1):
-            for subset in combinations(nodes, size):
-                subgraph = self.G.subgraph(subset)
-                if subgraph.number_of_nodes() > 0 and subgraph.number_of_edges() > 0:
-                    avg_deg = 2 * subgraph.number_of_edges() / subgraph.number_of_nodes()
-                    alpha_val = math.ceil(avg_deg)
-                    if alpha_val > max_alpha:
-                        max_alpha = alpha_val
-                        best_subgraph = subgraph.copy()
-        
-        return max_alpha, best_subgraph
+        best = self.G.subgraph(witnesses[k]).copy() if witnesses is not None else None
+        return int(alpha[k]), best
     
     def verify_approximation(self, k: int) -> dict:
         """
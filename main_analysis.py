@@ -15,13 +15,22 @@ import networkx as nx
 import matplotlib.pyplot as plt
 import numpy as np
 from tabulate import tabulate
+import multiprocessing
+import os
+import resource
 import sys
+import time
+from concurrent.futures import ProcessPoolExecutor
 
 # Import our implementations
 try:
     from snap_api import load_snap_graph, SNAPLoader
+    from dataset_catalog import plan_batches
     from large_set_arboricity import LargeSetArboricity
     from plot_alpha_k import plot_alpha_k_vs_k, compute_alpha_k_for_all_k
+    from exact_alpha import MAX_VERTICES as MAX_EXACT_VERTICES
+    from triangles import clustering_networkx
+    from graph_stats import graph_stats_networkx
 except ImportError as e:
     print(f"Error importing modules: {e}")
     print("Make sure snap_api.py, large_set_arboricity.py, and plot_alpha_k.py are in the same directory")
@@ -37,8 +46,9 @@ def analyze_graph_dk_only(G, graph_name, max_k=None):
         graph_name: Name for display
         max_k: Maximum k value (default: min(n-1, 50))
     """
-    n = G.number_of_nodes()
-    m = G.number_of_edges()
+    report = graph_stats_networkx(G)
+    n = report['n']
+    m = report['m']
     
     # Initialize
     lsa = LargeSetArboricity(G)
@@ -130,8 +140,9 @@ def analyze_graph_complete(G, graph_name, max_k=None):
         graph_name: Name of the graph for display
         max_k: Maximum k value to analyze (default: n-1)
     """
-    n = G.number_of_nodes()
-    m = G.number_of_edges()
+    report = graph_stats_networkx(G)
+    n = report['n']
+    m = report['m']
     
     print(f"\n{'='*80}")
     print(f"ANALYZING: {graph_name}")
@@ -141,11 +152,18 @@ def analyze_graph_complete(G, graph_name, max_k=None):
     print(f"\n📊 GRAPH PROPERTIES:")
     print(f"   Nodes (n):           {n}")
     print(f"   Edges (m):           {m}")
-    print(f"   Average degree:      {2*m/n:.2f}")
-    print(f"   Density:             {nx.density(G):.4f}")
-    print(f"   Connected:           {'Yes' if nx.is_connected(G) else 'No'}")
-    
-    if n > 15:
+    print(f"   Average degree:      {report['average_degree']:.2f}")
+    print(f"   Max degree:          {report['max_degree']}")
+    print(f"   Density:             {report['density']:.4f}")
+    print(f"   Connected:           {'Yes' if report['connected'] else 'No'}")
+    if not report['connected']:
+        print(f"   Components:          {report['components']} "
+              f"(largest: {report['largest_component']} nodes)")
+    stats = clustering_networkx(G)
+    print(f"   Avg clustering:      {stats['average_clustering']:.4f}")
+    print(f"   Transitivity:        {stats['transitivity']:.4f}")
+    
+    if n > MAX_EXACT_VERTICES:
         print(f"\n⚠️  Graph is too large (n={n}) for exact αk(G) computation.")
         print(f"   Only dk(G) will be computed (approximation).")
         # For large graphs, compute only dk
@@ -324,6 +342,21 @@ def create_correlation_plots(data_dict):
     return filename
 
 
+def run_dataset(graph_name):
+    """
+    Load and analyze one dataset; run in a worker process of its own.
+    
+    Returns:
+        (analysis data, peak resident bytes of the process, seconds)
+    """
+    start_time = time.time()
+    G = load_snap_graph(graph_name)
+    data = analyze_graph_complete(G, graph_name, max_k=G.number_of_nodes() - 1)
+    # ru_maxrss is in KiB on Linux
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss * 1024
+    return data, peak, time.time() - start_time
+
+
 def main():
     """Main program."""
     print("="*80)
@@ -339,47 +372,60 @@ def main():
         'wiki-Vote': 'Wikipedia voting network',
         'p2p-Gnutella08': 'P2P network (Gnutella)',
     '''
+    # Plan waves from the measured peak memory of earlier networkx runs
+    # (longest first): the graphs of one wave are loaded and analyzed
+    # concurrently, one process each, so a wave must fit in half the
+    # physical memory. Graphs never measured each run alone, last, and
+    # their peak is recorded for the next time.
+    catalog = SNAPLoader().catalog
+    memory_budget = os.sysconf('SC_PAGE_SIZE') * os.sysconf('SC_PHYS_PAGES') // 2
+    waves = plan_batches(catalog, small_graphs, memory_budget,
+                         workers=os.cpu_count() or 1, run='networkx')
+    
     print("\n📚 Available small SNAP graphs for analysis:")
-    for i, (name, desc) in enumerate(small_graphs.items(), 1):
-        print(f"   {i}. {name} - {desc}")
+    for w, wave in enumerate(waves, 1):
+        print(f"   Wave {w}:")
+        for name in wave:
+            estimate = catalog.estimate(name, run='networkx')
+            if estimate is not None:
+                print(f"     {name} - {small_graphs[name]} (measured peak "
+                      f"{estimate['memory_bytes'] / 2**20:.0f} MB, {estimate['seconds']:.1f}s)")
+            else:
+                print(f"     {name} - {small_graphs[name]} (not measured yet)")
     
     print("\n" + "="*80)
     
-    # Analyze each graph
+    # Analyze each wave
     results_all = []
     
-    for graph_name, description in small_graphs.items():
-        try:
-            print(f"\n\n🔄 Loading {graph_name}...")
-            
-            # Load graph
-            G = load_snap_graph(graph_name)
-            
-            # Check size
-            n = G.number_of_nodes()
-            '''
-            if n > 15:
-                print(f"⚠️  Skipping {graph_name} (n={n} > 15, too large for exact computation)")
-                continue
-            '''
-            # Analyze
-            data = analyze_graph_complete(G, graph_name, max_k=n-1)
-            
-            if data is not None:
-                results_all.append(data)
+    for wave in waves:
+        print(f"\n\n🔄 Analyzing {', '.join(wave)}...")
+        # A fresh process per graph, so its peak memory is its own
+        with ProcessPoolExecutor(max_workers=len(wave), max_tasks_per_child=1,
+                                 mp_context=multiprocessing.get_context('spawn')) as pool:
+            runs = {name: pool.submit(run_dataset, name) for name in wave}
+        
+        for graph_name in wave:
+            try:
+                data, peak, seconds = runs[graph_name].result()
+                catalog.record(graph_name, analysis_peak_bytes=peak, analysis_seconds=seconds)
+                print(f"\n📏 {graph_name}: peak {peak / 2**20:.0f} MB, {seconds:.1f}s")
+                
+                if data is not None:
+                    results_all.append(data)
+                    
+                    # Create plots based on type
+                    if data.get('dk_only', False):
+                        print(f"✓ dk-only analysis complete for {graph_name}")
+                    else:
+                        # Create correlation plots (only for small graphs with exact αk)
+                        print(f"\n📊 Creating correlation plots for {graph_name}...")
+                        create_correlation_plots(data)
                 
-                # Create plots based on type
-                if data.get('dk_only', False):
-                    print(f"✓ dk-only analysis complete for {graph_name}")
-                else:
-                    # Create correlation plots (only for small graphs with exact αk)
-                    print(f"\n📊 Creating correlation plots for {graph_name}...")
-                    create_correlation_plots(data)
-            
-        except Exception as e:
-            print(f"\n❌ Error analyzing {graph_name}: {e}")
-            import traceback
-            traceback.print_exc()
+            except Exception as e:
+                print(f"\n❌ Error analyzing {graph_name}: {e}")
+                import traceback
+                traceback.print_exc()
     
     # Summary across all graphs
     if results_all:
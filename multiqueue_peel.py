@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+"""
+Relaxed-priority parallel peeling with a MultiQueue of bucket queues
+
+The exact peel always removes a globally minimum-degree vertex, one at a
+time. Here every worker thread pops approximately-minimum vertices from
+queues of its own, so workers never wait for a global minimum:
+
+    queues:   workers · queues_per_worker bucket queues (per-queue degree
+              buckets and a min pointer); vertex v lives in queue hash(v),
+              whose worker owns v's degree
+    pop:      a worker picks two distinct queues of its own at random and
+              removes the lower of their minima (the MultiQueue two-choice
+              rule)
+    updates:  decrements of the worker's own vertices are applied at once;
+              decrements of other workers' vertices go to an outbox,
+              partitioned by destination worker
+    exchange: every `batch` pops each worker drains the outbox slices
+              addressed to it (prange over workers, no atomics); this is
+              the only barrier, and it carries no threshold: unlike the
+              round-synchronous peel (approximate_peel), the pop order
+              stays a relaxed minimum-degree order
+
+Rank error. A pop whose degree as seen by its worker is d has rank
+error = the number of vertices that had degree < d at the epoch start;
+the maximum and mean are reported, together with the degree gap to the
+epoch-start minimum. Seen degrees never undercount (pending decrements
+only lower degrees), so these values bound how far the pop order strays
+from a global bucket queue. At the start of every epoch the remaining
+vertices are counted per degree (summed over the per-queue bucket
+counts) from the global minimum up to the largest degree a pop of the
+epoch can see: degrees only fall, so the k-th pop from a queue sees at
+most the k-th smallest epoch-start degree in it, and a queue gives at
+most batch pops per epoch. The window therefore ends at the batch-th
+smallest degree of each queue, and every rank error is counted exactly.
+
+The profile is exact for the order that was produced: the (vertices,
+edges) state of every suffix of the removal order is counted in the full
+graph (anytime_bounds._suffix_states), so each dk value is the density
+of a real subgraph with more than k vertices, hence a lower bound on αk.
+"""
+
+import time
+import numpy as np
+from numba import njit, prange, get_num_threads
+from typing import Optional
+
+from large_set_arboricity import _compute_dk_from_states
+from anytime_bounds import _suffix_states
+
+
+@njit(cache=True)
+def _push(head: np.ndarray, nxt: np.ndarray, prv: np.ndarray, count: np.ndarray,
+          base: int, d: int, v: int) -> None:
+    h = head[base + d]
+    nxt[v] = h
+    prv[v] = -1
+    if h >= 0:
+        prv[h] = v
+    head[base + d] = v
+    count[base + d] += 1
+
+
+@njit(cache=True)
+def _unlink(head: np.ndarray, nxt: np.ndarray, prv: np.ndarray, count: np.ndarray,
+            base: int, d: int, v: int) -> None:
+    p = prv[v]
+    x = nxt[v]
+    if p >= 0:
+        nxt[p] = x
+    else:
+        head[base + d] = x
+    if x >= 0:
+        prv[x] = p
+    count[base + d] -= 1
+
+
+@njit(cache=True)
+def _queue_min(head: np.ndarray, qmin: np.ndarray, width: int, q: int) -> int:
+    """Smallest non-empty degree of queue q, or -1 if it is empty."""
+    d = qmin[q]
+    base = q * width
+    while d < width and head[base + d] < 0:
+        d += 1
+    qmin[q] = d
+    return d if d < width else -1
+
+
+@njit(cache=True)
+def _decrement(head: np.ndarray, nxt: np.ndarray, prv: np.ndarray, count: np.ndarray,
+               qmin: np.ndarray, degrees: np.ndarray, width: int, q: int, u: int) -> None:
+    """Move u one degree bucket down in its queue q."""
+    d = degrees[u]
+    _unlink(head, nxt, prv, count, q * width, d, u)
+    degrees[u] = d - 1
+    _push(head, nxt, prv, count, q * width, d - 1, u)
+    if d - 1 < qmin[q]:
+        qmin[q] = d - 1
+
+
+@njit(cache=True)
+def _xorshift(state: np.ndarray, w: int) -> int:
+    x = state[w]
+    x ^= x << np.uint64(13)
+    x ^= x >> np.uint64(7)
+    x ^= x << np.uint64(17)
+    state[w] = x
+    return int(x >> np.uint64(33))
+
+
+@njit(parallel=True, cache=True)
+def _multiqueue_peel(offsets: np.ndarray, neighbors: np.ndarray, queue_of: np.ndarray,
+                     workers: int, per_worker: int, batch: int, seed: int):
+    """
+    Relaxed peel (see module docstring).
+
+    Returns:
+        (order, seen_degree, rank_error, degree_gap, epoch_start,
+        cross_decrements) with epoch_start[i] the first pop of epoch i
+        (epoch_start[-1] = n)
+    """
+    n = len(offsets) - 1
+    num_queues = workers * per_worker
+    degrees = np.empty(n, dtype=np.int64)
+    max_degree = 0
+    for v in range(n):
+        degrees[v] = offsets[v + 1] - offsets[v]
+        max_degree = max(max_degree, degrees[v])
+    width = max_degree + 1
+
+    head = np.full(num_queues * width, -1, dtype=np.int64)
+    count = np.zeros(num_queues * width, dtype=np.int64)
+    nxt = np.empty(n, dtype=np.int64)
+    prv = np.empty(n, dtype=np.int64)
+    qmin = np.zeros(num_queues, dtype=np.int64)
+    for v in range(n):
+        _push(head, nxt, prv, count, queue_of[v] * width, degrees[v], v)
+    removed = np.zeros(n, dtype=np.bool_)
+
+    rng = np.empty(workers, dtype=np.uint64)
+    for w in range(workers):
+        rng[w] = np.uint64(seed * 0x9E3779B97F4A7C15 + w * 0xBF58476D1CE4E5B9 + 1) | np.uint64(1)
+
+    # Outbox capacity fits one pop of the largest degree, so every epoch progresses
+    capacity = max(max_degree, batch * (len(neighbors) // max(n, 1) + 1) * 2)
+    out = np.empty((workers, capacity), dtype=np.int32)
+    out_sorted = np.empty((workers, capacity), dtype=np.int32)
+    dst_start = np.zeros((workers, workers + 1), dtype=np.int64)
+    out_count = np.zeros(workers, dtype=np.int64)
+    popped = np.empty((workers, batch), dtype=np.int64)
+    seen = np.empty((workers, batch), dtype=np.int64)
+    npopped = np.zeros(workers, dtype=np.int64)
+
+    order = np.empty(n, dtype=np.int64)
+    seen_degree = np.empty(n, dtype=np.int64)
+    rank_error = np.empty(n, dtype=np.int64)
+    degree_gap = np.empty(n, dtype=np.int64)
+    epoch_start = np.empty(n + 1, dtype=np.int64)
+    done = 0
+    epochs = 0
+    cross = 0
+
+    while done < n:
+        # Epoch-start degree counts from the minimum up to the batch-th
+        # smallest degree of every queue, the largest degree a pop can see
+        lo = width
+        hi = 0
+        for q in range(num_queues):
+            d = _queue_min(head, qmin, width, q)
+            if d < 0:
+                continue
+            lo = min(lo, d)
+            total = count[q * width + d]
+            while total < batch and d < width - 1:
+                d += 1
+                total += count[q * width + d]
+            hi = max(hi, d)
+        below = np.zeros(hi - lo + 2, dtype=np.int64)
+        for d in range(lo, hi + 1):
+            total = 0
+            for q in range(num_queues):
+                total += count[q * width + d]
+            below[d - lo + 1] = below[d - lo] + total
+
+        for w in prange(workers):
+            cnt = 0
+            oc = 0
+            first = w * per_worker
+            while cnt < batch:
+                a = _xorshift(rng, w) % per_worker
+                b = a
+                if per_worker > 1:
+                    b = (a + 1 + _xorshift(rng, w) % (per_worker - 1)) % per_worker
+                a += first
+                b += first
+                da = _queue_min(head, qmin, width, a)
+                db = _queue_min(head, qmin, width, b)
+                q = a if db < 0 or (da >= 0 and da <= db) else b
+                d = da if q == a else db
+                if d < 0:
+                    # Both picks empty: fall back to any non-empty queue of this worker
+                    for r in range(first, first + per_worker):
+                        d = _queue_min(head, qmin, width, r)
+                        if d >= 0:
+                            q = r
+                            break
+                    if d < 0:
+                        break
+                v = head[q * width + d]
+                if cnt > 0 and oc + offsets[v + 1] - offsets[v] > capacity:
+                    break
+                _unlink(head, nxt, prv, count, q * width, d, v)
+                removed[v] = True
+                popped[w, cnt] = v
+                seen[w, cnt] = d
+                cnt += 1
+                for idx in range(offsets[v], offsets[v + 1]):
+                    u = neighbors[idx]
+                    if removed[u]:
+                        continue
+                    qu = queue_of[u]
+                    if qu // per_worker == w:
+                        _decrement(head, nxt, prv, count, qmin, degrees, width, qu, u)
+                    else:
+                        out[w, oc] = u
+                        oc += 1
+            npopped[w] = cnt
+            out_count[w] = oc
+
+            # Partition the outbox by destination worker
+            for t in range(workers + 1):
+                dst_start[w, t] = 0
+            for i in range(oc):
+                dst_start[w, queue_of[out[w, i]] // per_worker + 1] += 1
+            for t in range(workers):
+                dst_start[w, t + 1] += dst_start[w, t]
+            fill = dst_start[w, :workers].copy()
+            for i in range(oc):
+                t = queue_of[out[w, i]] // per_worker
+                out_sorted[w, fill[t]] = out[w, i]
+                fill[t] += 1
+
+        # Exchange: every worker applies the decrements addressed to it
+        for t in prange(workers):
+            for s in range(workers):
+                for i in range(dst_start[s, t], dst_start[s, t + 1]):
+                    u = out_sorted[s, i]
+                    if not removed[u]:
+                        _decrement(head, nxt, prv, count, qmin, degrees, width, queue_of[u], u)
+
+        # Interleave the workers' pops round-robin into the global order
+        epoch_start[epochs] = done
+        for i in range(batch):
+            for w in range(workers):
+                if i < npopped[w]:
+                    d = seen[w, i]
+                    order[done] = popped[w, i]
+                    seen_degree[done] = d
+                    rank_error[done] = below[d - lo] if d > lo else 0
+                    degree_gap[done] = d - lo
+                    done += 1
+        for w in range(workers):
+            cross += out_count[w]
+        epochs += 1
+    epoch_start[epochs] = n
+
+    return order, seen_degree, rank_error, degree_gap, epoch_start[:epochs + 1], cross
+
+
+def multiqueue_peel(offsets: np.ndarray, neighbors: np.ndarray, workers: Optional[int] = None,
+                    queues_per_worker: int = 2, batch: int = 256, seed: int = 0,
+                    verbose: bool = False) -> dict:
+    """
+    Relaxed-priority parallel peel and its dk profile.
+
+    Args:
+        offsets: CSR offsets
+        neighbors: CSR neighbours
+        workers: Worker threads (default: Numba's thread count)
+        queues_per_worker: Bucket queues per worker (MultiQueue factor c)
+        batch: Pops per worker between decrement exchanges
+        seed: Seed of the queue choices
+        verbose: Print a summary
+
+    Returns:
+        Dictionary with order, degree_at_removal (as seen by the popping
+        worker), vertices_at_step, edges_at_step (exact, for the produced
+        order), dk, rank_error (per pop), rank_error_max, rank_error_mean,
+        degree_gap_max, epochs, epoch_start (first pop of every epoch, then
+        n), cross_decrements and time
+    """
+    start_time = time.time()
+    n = len(offsets) - 1
+    workers = workers or get_num_threads()
+    num_queues = workers * queues_per_worker
+    # Fibonacci hashing spreads consecutive ids over the queues
+    queue_of = ((np.arange(n, dtype=np.uint64) * np.uint64(0x9E3779B97F4A7C15)) >> np.uint64(32)) \
+        % np.uint64(num_queues)
+    queue_of = queue_of.astype(np.int64)
+
+    order, seen, rank_error, gap, epoch_start, cross = _multiqueue_peel(
+        offsets, neighbors, queue_of, workers, queues_per_worker, batch, seed)
+    vertices_at_step, edges_at_step = _suffix_states(offsets, neighbors, order)
+    dk = _compute_dk_from_states(vertices_at_step, edges_at_step, n)
+
+    result = {
+        'order': order,
+        'degree_at_removal': seen,
+        'vertices_at_step': vertices_at_step,
+        'edges_at_step': edges_at_step,
+        'dk': dk,
+        'rank_error': rank_error,
+        'rank_error_max': int(rank_error.max()) if n > 0 else 0,
+        'rank_error_mean': float(rank_error.mean()) if n > 0 else 0.0,
+        'degree_gap_max': int(gap.max()) if n > 0 else 0,
+        'epochs': len(epoch_start) - 1,
+        'epoch_start': epoch_start,
+        'cross_decrements': int(cross),
+        'time': time.time() - start_time
+    }
+    if verbose:
+        print(f"✓ MultiQueue peel ({workers} workers × {queues_per_worker} queues, batch {batch}): "
+              f"{result['epochs']:,} epochs in {result['time']:.3f} seconds")
+        print(f"  Rank error: max {result['rank_error_max']:,}, mean {result['rank_error_mean']:.1f}; "
+              f"max degree gap {result['degree_gap_max']}")
+        print(f"  Cross-worker decrements: {result['cross_decrements']:,}")
+        print(f"  d_0 = {dk[0] if n > 0 else 0}")
+    return result
+
+
+if __name__ == "__main__":
+    import igraph as ig
+    from graph_csr import igraph_to_csr
+    from large_set_arboricity import _bucket_peel_csr
+
+    n = 500_000
+    G = ig.Graph.Barabasi(n, 8)
+    offsets, neighbors = igraph_to_csr(G)
+
+    print(f"\n{'='*70}")
+    print(f"MultiQueue peel: Barabási–Albert n={n:,}, m={G.ecount():,}")
+    print(f"{'='*70}")
+    # Warm up the Numba kernels so compilation is not timed
+    multiqueue_peel(np.array([0, 1, 2], dtype=np.int64), np.array([1, 0], dtype=np.int32), workers=2)
+    start_time = time.time()
+    _, _, pv, pe, _ = _bucket_peel_csr(offsets, neighbors)
+    exact = _compute_dk_from_states(pv, pe, n)
+    print(f"✓ Exact bucket peel: {time.time() - start_time:.3f} seconds, d_0 = {exact[0]}")
+
+    for workers in (1, 4, 16):
+        result = multiqueue_peel(offsets, neighbors, workers=workers, verbose=True)
+        print(f"  |dk - exact dk| ≤ {int(np.max(np.abs(result['dk'] - exact)))} over all k")
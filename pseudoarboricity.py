@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+"""
+Pseudoarboricity via minimum max-out-degree orientation
+
+The pseudoarboricity of G is
+    p(G) = max_{H ⊆ G} ⌈|E(H)| / |V(H)|⌉
+and equals the minimum over all orientations of G of the maximum out-degree.
+
+It sits between the arboricity and the degeneracy bound:
+    p(G) ≤ α(G) ≤ p(G) + 1,    p(G) ≤ degeneracy(G)
+
+Algorithm:
+1. Start from the degeneracy orientation (earlier removed → later removed)
+2. For target T = D-1, vertices with out-degree > T are sources and vertices
+   with out-degree < T are sinks; reversing a directed source→sink path moves
+   one unit of out-degree from the source to the sink
+3. Route all excess with Dinic-style blocking-flow phases (BFS layering from
+   all sources at once, then DFS with current-arc pointers)
+4. Success lowers D and repeats; failure proves D is optimal
+"""
+
+import numpy as np
+from numba import njit
+from typing import Tuple
+
+from graph_csr import edges_to_csr
+
+
+@njit(cache=True)
+def _bfs_levels(offsets: np.ndarray, neighbors: np.ndarray, edge_ids: np.ndarray,
+                tail: np.ndarray, outdeg: np.ndarray, target: int,
+                level: np.ndarray, queue: np.ndarray) -> bool:
+    """
+    Layer the residual graph from all overloaded vertices along out-edges.
+
+    Returns:
+        True if some underloaded vertex is reachable
+    """
+    n = len(outdeg)
+    head = 0
+    tail_q = 0
+    for v in range(n):
+        if outdeg[v] > target:
+            level[v] = 0
+            queue[tail_q] = v
+            tail_q += 1
+        else:
+            level[v] = -1
+
+    found = False
+    while head < tail_q:
+        v = queue[head]
+        head += 1
+        for idx in range(offsets[v], offsets[v + 1]):
+            if tail[edge_ids[idx]] != v:
+                continue
+            u = neighbors[idx]
+            if level[u] < 0:
+                level[u] = level[v] + 1
+                if outdeg[u] < target:
+                    found = True
+                queue[tail_q] = u
+                tail_q += 1
+
+    return found
+
+
+@njit(cache=True)
+def _blocking_flow(offsets: np.ndarray, neighbors: np.ndarray, edge_ids: np.ndarray,
+                   tail: np.ndarray, outdeg: np.ndarray, target: int,
+                   level: np.ndarray, ptr: np.ndarray,
+                   stack_v: np.ndarray, stack_e: np.ndarray) -> int:
+    """
+    Reverse source→sink paths in the layered graph until none remain.
+
+    Returns:
+        Number of paths reversed in this phase
+    """
+    n = len(outdeg)
+    for v in range(n):
+        ptr[v] = offsets[v]
+
+    reversed_paths = 0
+    for s in range(n):
+        while outdeg[s] > target and level[s] == 0:
+            # Iterative DFS along level-increasing out-edges
+            depth = 0
+            stack_v[0] = s
+            reached = False
+            while depth >= 0:
+                v = stack_v[depth]
+                if depth > 0 and outdeg[v] < target:
+                    reached = True
+                    break
+
+                advanced = False
+                while ptr[v] < offsets[v + 1]:
+                    idx = ptr[v]
+                    e = edge_ids[idx]
+                    u = neighbors[idx]
+                    if tail[e] == v and level[u] == level[v] + 1:
+                        stack_e[depth] = e
+                        depth += 1
+                        stack_v[depth] = u
+                        advanced = True
+                        break
+                    ptr[v] += 1
+
+                if not advanced:
+                    # Dead end: drop v from the layered graph
+                    level[v] = -1
+                    depth -= 1
+                    if depth >= 0:
+                        ptr[stack_v[depth]] += 1
+
+            if not reached:
+                break
+
+            # Reverse the path s → ... → sink
+            for d in range(depth):
+                e = stack_e[d]
+                tail[e] = stack_v[d + 1]
+            outdeg[s] -= 1
+            outdeg[stack_v[depth]] += 1
+            reversed_paths += 1
+
+    return reversed_paths
+
+
+@njit(cache=True)
+def _refine_orientation(offsets: np.ndarray, neighbors: np.ndarray, edge_ids: np.ndarray,
+                        tail: np.ndarray, outdeg: np.ndarray, lower_bound: int) -> int:
+    """
+    Lower the maximum out-degree of the orientation until it is optimal.
+
+    Args:
+        tail: Tail vertex of every edge (modified in place)
+        outdeg: Out-degree of every vertex (modified in place)
+        lower_bound: Known lower bound on the optimum (e.g. ⌈m/n⌉)
+
+    Returns:
+        Minimum achievable maximum out-degree
+    """
+    n = len(outdeg)
+    level = np.empty(n, dtype=np.int32)
+    queue = np.empty(n, dtype=np.int32)
+    ptr = np.empty(n, dtype=np.int64)
+    stack_v = np.empty(n + 1, dtype=np.int32)
+    stack_e = np.empty(n + 1, dtype=np.int32)
+
+    best = 0
+    for v in range(n):
+        if outdeg[v] > best:
+            best = outdeg[v]
+
+    while best > lower_bound:
+        target = best - 1
+        while True:
+            if not _bfs_levels(offsets, neighbors, edge_ids, tail, outdeg,
+                               target, level, queue):
+                break
+            if _blocking_flow(offsets, neighbors, edge_ids, tail, outdeg,
+                              target, level, ptr, stack_v, stack_e) == 0:
+                break
+
+        overloaded = False
+        for v in range(n):
+            if outdeg[v] > target:
+                overloaded = True
+                break
+        if overloaded:
+            break
+        best = target
+
+    return best
+
+
+def compute_pseudoarboricity(edges: np.ndarray, n: int,
+                             order: np.ndarray) -> Tuple[int, np.ndarray]:
+    """
+    Compute the pseudoarboricity and an optimal orientation.
+
+    Args:
+        edges: (m, 2) edge array
+        n: Number of vertices
+        order: Degeneracy (removal) order of the vertices
+
+    Returns:
+        (pseudoarboricity, oriented_edges) where oriented_edges[i] = (tail, head)
+    """
+    edges = np.asarray(edges, dtype=np.int64).reshape(-1, 2)
+    m = len(edges)
+    if m == 0:
+        return 0, edges.copy()
+
+    # Degeneracy orientation: earlier removed vertex → later removed vertex
+    position = np.empty(n, dtype=np.int64)
+    position[order] = np.arange(n)
+    first = position[edges[:, 0]] <= position[edges[:, 1]]
+    tail = np.where(first, edges[:, 0], edges[:, 1]).astype(np.int32)
+    outdeg = np.bincount(tail, minlength=n).astype(np.int32)
+
+    offsets, neighbors, edge_ids = edges_to_csr(edges, n, with_edge_ids=True)
+    lower_bound = -(-m // n)
+
+    p = _refine_orientation(offsets, neighbors, edge_ids, tail, outdeg, lower_bound)
+
+    head = np.where(tail == edges[:, 0], edges[:, 1], edges[:, 0])
+    oriented = np.stack((tail.astype(np.int64), head), axis=1)
+    return int(p), oriented
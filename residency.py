@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+"""
+Memory-budgeted residency of graphs, derived indices and results
+
+A long-running analysis process keeps many CSR graphs and their derived
+arrays around. ResidencyManager holds them under keys, counts the bytes
+of every entry (the arrays inside dicts, lists and tuples) and, when the
+total goes over the budget, evicts the least recently used entries until
+it fits again.
+
+How an entry comes back depends on where its bytes live:
+
+    mapped   (every array is an np.memmap, e.g. load_arrays() of the CSR
+              cache): dropped; the file is already on disk, the next get()
+              maps it again
+    loadable (registered with a load function): dropped; the next get()
+              calls the function again
+    computed (put() without a load function): 1-D arrays and dicts of them
+              are written to the spill directory with save_arrays() and
+              mapped back on the next get(); anything else, or anything
+              without a spill directory, is pinned
+
+Reloads are transparent: get() returns the value whether it was resident
+or not. The entry being returned is never evicted to make room for
+itself, so a single entry larger than the budget still loads. The
+manager only drops its own references; arrays a caller still holds stay
+alive until the caller lets them go.
+"""
+
+import os
+import threading
+from collections import OrderedDict
+from typing import Any, Callable, Dict, Hashable, Optional
+
+import numpy as np
+
+from graph_csr import load_arrays, save_arrays
+
+
+def value_nbytes(value: Any) -> tuple:
+    """
+    Bytes of the arrays in a value (arrays nested in dicts, lists, tuples).
+
+    Args:
+        value: Array, container of arrays, or anything else (0 bytes)
+
+    Returns:
+        (total_bytes, mapped_bytes) where mapped bytes belong to np.memmap arrays
+    """
+    if isinstance(value, np.ndarray):
+        mapped = isinstance(value, np.memmap) or isinstance(value.base, np.memmap)
+        return value.nbytes, value.nbytes if mapped else 0
+    if isinstance(value, (dict, list, tuple)):
+        total = mapped = 0
+        for item in (value.values() if isinstance(value, dict) else value):
+            t, mp = value_nbytes(item)
+            total += t
+            mapped += mp
+        return total, mapped
+    return 0, 0
+
+
+def _spillable(value: Any) -> bool:
+    """True for a 1-D array or a dict of 1-D arrays (what save_arrays() stores)."""
+    if isinstance(value, dict):
+        return all(isinstance(v, np.ndarray) and v.ndim == 1 for v in value.values())
+    return isinstance(value, np.ndarray) and value.ndim == 1
+
+
+class _Entry:
+    __slots__ = ('value', 'load', 'nbytes', 'mapped', 'spill_path', 'expected')
+
+    def __init__(self, load: Optional[Callable[[], Any]], expected: int = 0):
+        self.value = None
+        self.load = load
+        self.nbytes = 0
+        self.mapped = False
+        self.spill_path = None
+        self.expected = expected
+
+
+class ResidencyManager:
+    """
+    LRU cache of graph data under a memory budget.
+    """
+
+    def __init__(self, budget_bytes: int, spill_dir: Optional[str] = None):
+        """
+        Args:
+            budget_bytes: Bytes of resident entries to stay under
+            spill_dir: Directory for evicted computed results (None: pin them)
+        """
+        self.budget_bytes = budget_bytes
+        self.spill_dir = spill_dir
+        if spill_dir is not None:
+            os.makedirs(spill_dir, exist_ok=True)
+
+        self._entries: Dict[Hashable, _Entry] = {}
+        self._resident: 'OrderedDict[Hashable, None]' = OrderedDict()
+        self._lock = threading.RLock()
+        self.resident_bytes = 0
+        self.counters = {'hits': 0, 'loads': 0, 'reloads': 0, 'evictions': 0, 'spills': 0}
+
+    def register(self, key: Hashable, load: Callable[[], Any], expected_bytes: int = 0) -> None:
+        """
+        Declare an entry that is loaded on first access.
+
+        Args:
+            key: Entry key, e.g. ('ca-GrQc', 'csr')
+            load: Returns the value; called again after an eviction
+            expected_bytes: Size estimate (e.g. from the dataset catalog);
+                            room is made before loading
+        """
+        with self._lock:
+            if key in self._entries:
+                self._drop(key)
+            self._entries[key] = _Entry(load, expected_bytes)
+
+    def put(self, key: Hashable, value: Any, load: Optional[Callable[[], Any]] = None) -> Any:
+        """
+        Insert a computed value (a derived index or result).
+
+        Args:
+            key: Entry key, e.g. ('ca-GrQc', 'coreness')
+            value: Array or dict/list/tuple of arrays
+            load: Recomputes the value after an eviction; if omitted, a
+                  1-D array or dict of 1-D arrays is spilled, anything else
+                  (or anything without a spill directory) is pinned
+
+        Returns:
+            value
+        """
+        with self._lock:
+            if key in self._entries:
+                self._drop(key)
+            entry = _Entry(load)
+            self._entries[key] = entry
+            self._admit(key, entry, value)
+            return value
+
+    def get(self, key: Hashable) -> Any:
+        """
+        Value of an entry, loading or reloading it if it is not resident.
+
+        Args:
+            key: Entry key
+
+        Returns:
+            The value
+        """
+        with self._lock:
+            entry = self._entries[key]
+            if entry.value is not None:
+                self._resident.move_to_end(key)
+                self.counters['hits'] += 1
+                return entry.value
+
+            if entry.spill_path is not None:
+                arrays = load_arrays(entry.spill_path, mmap=True)
+                value = arrays['value'] if set(arrays) == {'value'} else arrays
+                self.counters['reloads'] += 1
+            else:
+                if entry.expected > 0:
+                    self._evict(self.budget_bytes - entry.expected, keep=key)
+                value = entry.load()
+                self.counters['reloads' if entry.nbytes > 0 else 'loads'] += 1
+
+            self._admit(key, entry, value)
+            return value
+
+    def get_or_compute(self, key: Hashable, compute: Callable[[], Any]) -> Any:
+        """get() for a derived entry, computed (and registered) on first use."""
+        with self._lock:
+            if key not in self._entries:
+                self.register(key, compute)
+            return self.get(key)
+
+    def __contains__(self, key: Hashable) -> bool:
+        return key in self._entries
+
+    def is_resident(self, key: Hashable) -> bool:
+        """True if the entry is currently held in memory (or mapped)."""
+        with self._lock:
+            return key in self._resident
+
+    def evict(self, key: Hashable) -> None:
+        """Evict one entry now (it stays reloadable)."""
+        with self._lock:
+            if key in self._resident:
+                self._evict_entry(key)
+
+    def remove(self, key: Hashable) -> None:
+        """Forget an entry entirely, deleting its spill file."""
+        with self._lock:
+            self._drop(key)
+            del self._entries[key]
+
+    def stats(self) -> dict:
+        """
+        Residency summary.
+
+        Returns:
+            Dictionary with budget_bytes, resident_bytes, mapped_bytes,
+            entries, resident, pinned and the hit/load/reload/eviction/spill counters
+        """
+        with self._lock:
+            resident = [self._entries[key] for key in self._resident]
+            return dict(self.counters,
+                        budget_bytes=self.budget_bytes,
+                        resident_bytes=self.resident_bytes,
+                        mapped_bytes=sum(e.nbytes for e in resident if e.mapped),
+                        entries=len(self._entries),
+                        resident=len(resident),
+                        pinned=sum(1 for e in resident if not self._evictable(e)))
+
+    def _admit(self, key: Hashable, entry: _Entry, value: Any) -> None:
+        """Make value resident under key, then evict others down to the budget."""
+        total, mapped = value_nbytes(value)
+        entry.value = value
+        entry.nbytes = total
+        entry.mapped = total > 0 and mapped == total
+        self._resident[key] = None
+        self._resident.move_to_end(key)
+        self.resident_bytes += total
+        self._evict(self.budget_bytes, keep=key)
+
+    def _evict(self, target: int, keep: Hashable) -> None:
+        """Evict least recently used entries until resident bytes ≤ target."""
+        for key in list(self._resident):
+            if self.resident_bytes <= target:
+                break
+            if key != keep and self._evictable(self._entries[key]):
+                self._evict_entry(key)
+
+    def _evictable(self, entry: _Entry) -> bool:
+        return (entry.mapped or entry.load is not None or entry.spill_path is not None
+                or (self.spill_dir is not None and _spillable(entry.value)))
+
+    def _evict_entry(self, key: Hashable) -> None:
+        entry = self._entries[key]
+        if not entry.mapped and entry.load is None and entry.spill_path is None:
+            self._spill(key, entry)
+        entry.value = None
+        del self._resident[key]
+        self.resident_bytes -= entry.nbytes
+        self.counters['evictions'] += 1
+
+    def _spill(self, key: Hashable, entry: _Entry) -> None:
+        """Write a computed value to the spill directory (dict of arrays or one array)."""
+        value = entry.value
+        arrays = value if isinstance(value, dict) else {'value': value}
+        path = os.path.join(self.spill_dir, f'spill-{os.getpid()}-{self.counters["spills"]}.bin')
+        save_arrays(path, {name: np.asarray(arr) for name, arr in arrays.items()})
+        entry.spill_path = path
+        self.counters['spills'] += 1
+
+    def _drop(self, key: Hashable) -> None:
+        """Release an entry's value and spill file without counting an eviction."""
+        entry = self._entries[key]
+        if key in self._resident:
+            del self._resident[key]
+            self.resident_bytes -= entry.nbytes
+        entry.value = None
+        if entry.spill_path is not None and os.path.exists(entry.spill_path):
+            os.remove(entry.spill_path)
+        entry.spill_path = None
+
+
+def snap_residency(loader, budget_bytes: int, spill_dir: Optional[str] = None,
+                   datasets=None) -> ResidencyManager:
+    """
+    ResidencyManager with the CSR cache of SNAP datasets registered as ('name', 'csr').
+
+    The CSRs are memory-mapped from {cache_dir}/{name}.csr.bin, so evicting
+    one only unmaps it. Measured CSR sizes from the dataset catalog are
+    used to make room before a load.
+
+    Args:
+        loader: SNAPLoader
+        budget_bytes: Memory budget
+        spill_dir: Spill directory for computed results (default: {cache_dir}/spill)
+        datasets: Dataset names (default: all known datasets)
+
+    Returns:
+        ResidencyManager
+    """
+    manager = ResidencyManager(budget_bytes,
+                               spill_dir or os.path.join(loader.cache_dir, 'spill'))
+    for name in datasets if datasets is not None else loader.DATASETS:
+        entry = loader.catalog.get(name)
+        manager.register((name, 'csr'), lambda name=name: loader.load_csr(name),
+                         expected_bytes=entry['csr_bytes'] if entry else 0)
+    return manager
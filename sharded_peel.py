@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+"""
+Sharded approximate peeling across local worker processes
+
+Vertices are partitioned across worker processes. Each worker holds only its
+shard: the CSR of its owned vertices, with neighbour ids rewritten as
+    0 .. n_local-1            owned vertex (local index)
+    n_local .. n_local+g-1    ghost vertex (index into the ghost map)
+and a ghost map (global id and owner shard of every ghost).
+
+Rounds are bulk-synchronous, with the parent acting as coordinator:
+1. Parent broadcasts the round threshold ⌊(1+ε)·2m/n⌋
+2. Each worker removes its owned vertices at or below the threshold,
+   applies decrements to owned neighbours directly and batches the
+   decrements to ghosts per owner shard
+3. Parent routes the batches; each worker applies the ones it receives
+4. Workers report remaining vertices and degree sum; parent records (n, m)
+
+The recorded states match approximate_peel_states() round for round, so
+the resulting dk profile equals the single-process approximate mode.
+Local processes stand in for cluster nodes. They are started with the
+'spawn' method: forking after Numba's threading layer is up leaves the
+parent hung at exit. A worker that fails sends its traceback before it
+exits; the coordinator raises the first failure (ShardWorkerError) rather
+than the broken pipe it leaves behind.
+"""
+
+import multiprocessing as mp
+import traceback
+import numpy as np
+from typing import List, Optional, Tuple, Union
+
+from approximate_peel import round_threshold
+from graph_csr import load_arrays
+
+# Workers start in a fresh interpreter (see module notes)
+_MP_CONTEXT = mp.get_context('spawn')
+
+
+class ShardWorkerError(RuntimeError):
+    """A shard worker failed; the message carries its traceback or exit code."""
+
+
+def build_shards(offsets: np.ndarray, neighbors: np.ndarray,
+                 owner: np.ndarray, num_shards: int) -> List[dict]:
+    """
+    Split a CSR into per-shard CSRs with ghost-vertex maps.
+
+    Args:
+        offsets: CSR offsets (int64[n+1])
+        neighbors: CSR neighbours (int32[2m])
+        owner: Shard id of every vertex (int32[n])
+        num_shards: Number of shards
+
+    Returns:
+        List of shard dictionaries (vertices, offsets, neighbors,
+        ghost_vertices, ghost_owner)
+    """
+    n = len(offsets) - 1
+    degrees = np.diff(offsets)
+    local_index = np.empty(n, dtype=np.int64)
+    shards = []
+
+    for s in range(num_shards):
+        vertices = np.flatnonzero(owner == s).astype(np.int32)
+        local_index[vertices] = np.arange(len(vertices))
+
+        shard_degrees = degrees[vertices]
+        shard_offsets = np.zeros(len(vertices) + 1, dtype=np.int64)
+        np.cumsum(shard_degrees, out=shard_offsets[1:])
+
+        # Gather the adjacency of owned vertices (global ids)
+        starts = np.repeat(offsets[vertices] - shard_offsets[:-1], shard_degrees)
+        global_nbrs = neighbors[starts + np.arange(shard_offsets[-1])]
+
+        # Rewrite neighbours as local / ghost indices
+        is_owned = owner[global_nbrs] == s
+        ghost_vertices = np.unique(global_nbrs[~is_owned]).astype(np.int32)
+        local_nbrs = np.empty(len(global_nbrs), dtype=np.int32)
+        local_nbrs[is_owned] = local_index[global_nbrs[is_owned]]
+        local_nbrs[~is_owned] = len(vertices) + np.searchsorted(ghost_vertices,
+                                                                global_nbrs[~is_owned])
+
+        shards.append({
+            'vertices': vertices,
+            'offsets': shard_offsets,
+            'neighbors': local_nbrs,
+            'ghost_vertices': ghost_vertices,
+            'ghost_owner': owner[ghost_vertices].astype(np.int32),
+        })
+
+    return shards
+
+
+def _shard_worker(conn, shard: Union[dict, str], shard_id: int, num_shards: int) -> None:
+    """Worker process: serve one shard, sending any failure to the coordinator."""
+    try:
+        _serve_shard(conn, shard, shard_id, num_shards)
+    except Exception:
+        try:
+            conn.send(ShardWorkerError(f"Shard {shard_id} worker failed:\n{traceback.format_exc()}"))
+        except OSError:
+            pass  # Coordinator already gone
+    finally:
+        conn.close()
+
+
+def _serve_shard(conn, shard: Union[dict, str], shard_id: int, num_shards: int) -> None:
+    """Worker loop: owns one shard and answers coordinator messages."""
+    if isinstance(shard, str):
+        # Shard file from graph_partition.py: map it instead of receiving a copy
+        shard = load_arrays(shard, mmap=True)
+    vertices = shard['vertices']
+    offsets = shard['offsets']
+    neighbors = shard['neighbors']
+    ghost_vertices = shard['ghost_vertices']
+    ghost_owner = shard['ghost_owner']
+    n_local = len(vertices)
+
+    degrees = np.diff(offsets).astype(np.int64)
+    alive = np.ones(n_local, dtype=bool)
+    conn.send((n_local, int(degrees.sum())))
+
+    while True:
+        msg = conn.recv()
+        if msg[0] == 'stop':
+            break
+
+        if msg[0] == 'round':
+            threshold = msg[1]
+            frontier = np.flatnonzero(alive & (degrees <= threshold))
+            alive[frontier] = False
+
+            # Decrement targets of every removed vertex
+            lengths = offsets[frontier + 1] - offsets[frontier]
+            starts = np.repeat(offsets[frontier] - np.cumsum(lengths) + lengths, lengths)
+            targets = neighbors[starts + np.arange(lengths.sum())]
+
+            owned = targets[targets < n_local]
+            degrees -= np.bincount(owned, minlength=n_local)
+
+            # Batch ghost decrements per owner shard (as global ids)
+            ghosts = targets[targets >= n_local] - n_local
+            batches = [None] * num_shards
+            for s in range(num_shards):
+                if s != shard_id:
+                    batches[s] = ghost_vertices[ghosts[ghost_owner[ghosts] == s]]
+            conn.send(batches)
+
+        elif msg[0] == 'apply':
+            incoming = msg[1]
+            if len(incoming) > 0:
+                local = np.searchsorted(vertices, incoming)
+                degrees -= np.bincount(local, minlength=n_local)
+            conn.send((int(alive.sum()), int(degrees[alive].sum())))
+
+
+def _receive(conn):
+    """Next coordinator-bound message; raises a worker's reported failure."""
+    msg = conn.recv()
+    if isinstance(msg, ShardWorkerError):
+        raise msg
+    return msg
+
+
+def _worker_failure(conns, procs) -> Optional[ShardWorkerError]:
+    """First failure of a shard worker in shard order, reported or by exit code."""
+    for s, (c, p) in enumerate(zip(conns, procs)):
+        try:
+            while c.poll():
+                msg = c.recv()
+                if isinstance(msg, ShardWorkerError):
+                    return msg
+        except (EOFError, OSError):
+            p.join(timeout=1.0)
+        if p.exitcode not in (None, 0):
+            return ShardWorkerError(f"Shard {s} worker exited with code {p.exitcode}")
+    return None
+
+
+def sharded_peel_states(offsets: np.ndarray, neighbors: np.ndarray,
+                        num_shards: int = 4, epsilon: float = 0.1,
+                        owner: Optional[np.ndarray] = None,
+                        shards: Optional[List[Union[dict, str]]] = None) -> Tuple[np.ndarray, np.ndarray, dict]:
+    """
+    Run approximate peeling with vertices sharded across worker processes.
+
+    Args:
+        offsets: CSR offsets (int64[n+1])
+        neighbors: CSR neighbours (int32[2m])
+        num_shards: Number of worker processes
+        epsilon: Round threshold slack ε > 0
+        owner: Shard id of every vertex (default: contiguous ranges)
+        shards: Prebuilt shards or shard file paths written by graph_partition.py
+                (overrides offsets/neighbors/owner)
+
+    Returns:
+        (vertices_at_round, edges_at_round, stats) where stats counts
+        rounds and cross-shard decrement messages
+    """
+    if shards is None:
+        n = len(offsets) - 1
+        if owner is None:
+            owner = (np.arange(n, dtype=np.int64) * num_shards // max(1, n)).astype(np.int32)
+        shards = build_shards(offsets, neighbors, owner, num_shards)
+    num_shards = len(shards)
+
+    conns = []
+    procs = []
+    for s, shard in enumerate(shards):
+        parent_conn, child_conn = _MP_CONTEXT.Pipe()
+        p = _MP_CONTEXT.Process(target=_shard_worker, args=(child_conn, shard, s, num_shards))
+        p.start()
+        child_conn.close()
+        conns.append(parent_conn)
+        procs.append(p)
+
+    try:
+        initial = [_receive(c) for c in conns]
+        vertices = sum(v for v, _ in initial)
+        edges = sum(d for _, d in initial) // 2
+
+        vertices_at_round = [vertices]
+        edges_at_round = [edges]
+        cross_shard_decrements = 0
+
+        while vertices > 0:
+            threshold = round_threshold(vertices, edges, epsilon)
+            for c in conns:
+                c.send(('round', threshold))
+            outgoing = [_receive(c) for c in conns]
+
+            # Route batched boundary decrements to their owner shards
+            for s, c in enumerate(conns):
+                parts = [outgoing[src][s] for src in range(num_shards) if src != s]
+                incoming = np.concatenate(parts) if parts else np.zeros(0, dtype=np.int32)
+                cross_shard_decrements += len(incoming)
+                c.send(('apply', incoming))
+
+            reports = [_receive(c) for c in conns]
+            vertices = sum(v for v, _ in reports)
+            edges = sum(d for _, d in reports) // 2
+            vertices_at_round.append(vertices)
+            edges_at_round.append(edges)
+
+    except (EOFError, OSError) as exc:
+        # A dead worker breaks the pipes; report why it died instead
+        failure = _worker_failure(conns, procs)
+        if failure is None:
+            raise
+        raise failure from exc
+    finally:
+        for c in conns:
+            try:
+                c.send(('stop',))
+            except (BrokenPipeError, EOFError, OSError):
+                pass  # Worker already gone
+            c.close()
+        for p in procs:
+            p.join()
+
+    stats = {
+        'num_shards': num_shards,
+        'rounds': len(vertices_at_round) - 1,
+        'cross_shard_decrements': cross_shard_decrements,
+    }
+    return (np.array(vertices_at_round, dtype=np.int32),
+            np.array(edges_at_round, dtype=np.int32),
+            stats)
@@ -8,10 +8,15 @@ Works on Windows/Fedora with caching support
 import networkx as nx
 import urllib.request
 import gzip
-import io
 import os
+import time
+import numpy as np
 from typing import Optional, Dict
 
+from graph_csr import edge_file_to_csr, save_arrays, load_arrays
+from graph_stats import graph_stats, graph_stats_networkx, print_graph_stats
+from dataset_catalog import DatasetCatalog
+
 
 class SNAPLoader:
     """
@@ -20,6 +25,7 @@ class SNAPLoader:
     Features:
     - Downloads from Stanford SNAP
     - Local caching to avoid re-downloads
+    - Binary CSR cache (mmappable) for the NumPy/Numba engines
     - Support for 20+ popular SNAP datasets
     - Automatic graph preprocessing
     """
@@ -58,29 +64,29 @@ class SNAPLoader:
         'amazon0601': 'https://snap.stanford.edu/data/amazon0601.txt.gz',
     }
     
-    # Dataset metadata (approximate sizes)
-    METADATA = {
-        'ca-GrQc': {'n': 5242, 'm': 14496, 'desc': 'General Relativity collaboration'},
-        'ca-HepTh': {'n': 9877, 'm': 25998, 'desc': 'High Energy Physics Theory collaboration'},
-        'ca-HepPh': {'n': 12008, 'm': 118521, 'desc': 'High Energy Physics Phenomenology'},
-        'ca-AstroPh': {'n': 18772, 'm': 198110, 'desc': 'Astrophysics collaboration'},
-        'ca-CondMat': {'n': 23133, 'm': 93497, 'desc': 'Condensed Matter collaboration'},
-        'ego-Facebook': {'n': 4039, 'm': 88234, 'desc': 'Facebook social circles'},
-        'ego-Gplus': {'n': 107614, 'm': 13673453, 'desc': 'Google+ social circles'},
-        'ego-Twitter': {'n': 81306, 'm': 1768149, 'desc': 'Twitter social circles'},
-        'soc-Epinions1': {'n': 75879, 'm': 508837, 'desc': 'Epinions trust network'},
-        'soc-Slashdot0811': {'n': 77360, 'm': 905468, 'desc': 'Slashdot social network'},
-        'soc-Slashdot0902': {'n': 82168, 'm': 948464, 'desc': 'Slashdot social network'},
-        'email-Enron': {'n': 36692, 'm': 183831, 'desc': 'Enron email network'},
-        'email-EuAll': {'n': 265214, 'm': 420045, 'desc': 'EU email network'},
-        'wiki-Vote': {'n': 7115, 'm': 103689, 'desc': 'Wikipedia voting network'},
-        'p2p-Gnutella04': {'n': 10876, 'm': 39994, 'desc': 'Gnutella P2P network'},
-        'p2p-Gnutella08': {'n': 6301, 'm': 20777, 'desc': 'Gnutella P2P network'},
-        'p2p-Gnutella09': {'n': 8114, 'm': 26013, 'desc': 'Gnutella P2P network'},
-        'amazon0302': {'n': 262111, 'm': 1234877, 'desc': 'Amazon product network'},
-        'amazon0312': {'n': 400727, 'm': 3200440, 'desc': 'Amazon product network'},
-        'amazon0505': {'n': 410236, 'm': 3356824, 'desc': 'Amazon product network'},
-        'amazon0601': {'n': 403394, 'm': 3387388, 'desc': 'Amazon product network'},
+    # Dataset descriptions; sizes come from the measured catalog (see ingest())
+    DESCRIPTIONS = {
+        'ca-GrQc': 'General Relativity collaboration',
+        'ca-HepTh': 'High Energy Physics Theory collaboration',
+        'ca-HepPh': 'High Energy Physics Phenomenology',
+        'ca-AstroPh': 'Astrophysics collaboration',
+        'ca-CondMat': 'Condensed Matter collaboration',
+        'ego-Facebook': 'Facebook social circles',
+        'ego-Gplus': 'Google+ social circles',
+        'ego-Twitter': 'Twitter social circles',
+        'soc-Epinions1': 'Epinions trust network',
+        'soc-Slashdot0811': 'Slashdot social network',
+        'soc-Slashdot0902': 'Slashdot social network',
+        'email-Enron': 'Enron email network',
+        'email-EuAll': 'EU email network',
+        'wiki-Vote': 'Wikipedia voting network',
+        'p2p-Gnutella04': 'Gnutella P2P network',
+        'p2p-Gnutella08': 'Gnutella P2P network',
+        'p2p-Gnutella09': 'Gnutella P2P network',
+        'amazon0302': 'Amazon product network',
+        'amazon0312': 'Amazon product network',
+        'amazon0505': 'Amazon product network',
+        'amazon0601': 'Amazon product network',
     }
     
     def __init__(self, cache_dir: str = './snap_cache'):
@@ -92,6 +98,7 @@ class SNAPLoader:
         """
         self.cache_dir = cache_dir
         os.makedirs(cache_dir, exist_ok=True)
+        self.catalog = DatasetCatalog(os.path.join(cache_dir, 'catalog.json'))
     
     def load(self, dataset_name: str, 
              use_cache: bool = True,
@@ -113,47 +120,196 @@ class SNAPLoader:
             raise ValueError(f"Unknown dataset: {dataset_name}\n"
                            f"Available: {list(self.DATASETS.keys())}")
         
-        # Get metadata
-        meta = self.METADATA.get(dataset_name, {})
         print(f"Loading {dataset_name}...")
-        if 'desc' in meta:
-            print(f"  Description: {meta['desc']}")
-        if 'n' in meta and 'm' in meta:
-            print(f"  Expected: ~{meta['n']:,} nodes, ~{meta['m']:,} edges")
+        if dataset_name in self.DESCRIPTIONS:
+            print(f"  Description: {self.DESCRIPTIONS[dataset_name]}")
+        entry = self.catalog.get(dataset_name)
+        if entry is not None:
+            print(f"  Measured: {entry['n']:,} nodes, {entry['m']:,} edges "
+                  f"(largest component {entry['largest_component']:,} nodes)")
         
         # Download/load
         G = self._download_and_parse(dataset_name, use_cache)
         
-        # Preprocessing
-        if remove_self_loops:
-            n_self_loops = nx.number_of_selfloops(G)
-            if n_self_loops > 0:
-                G.remove_edges_from(nx.selfloop_edges(G))
-                print(f"  Removed {n_self_loops} self-loops")
+        # Preprocessing (decided from one statistics sweep of the parsed graph)
+        report = graph_stats_networkx(G)
+        changed = False
+        if remove_self_loops and report['self_loops'] > 0:
+            G.remove_edges_from(list(nx.selfloop_edges(G)))
+            print(f"  Removed {report['self_loops']} self-loops")
+            changed = True
         
-        if largest_component and not nx.is_connected(G):
-            components = list(nx.connected_components(G))
-            largest = max(components, key=len)
+        if largest_component and not report['connected']:
+            largest = max(nx.connected_components(G), key=len)
             G = G.subgraph(largest).copy()
             print(f"  Extracted largest component: {len(largest):,} nodes")
+            changed = True
         
-        n = G.number_of_nodes()
-        m = G.number_of_edges()
-        print(f"✓ Loaded: {n:,} nodes, {m:,} edges")
-        print(f"  Average degree: {2*m/n:.2f}")
+        if changed:
+            report = graph_stats_networkx(G)
+        print(f"✓ Loaded: {report['n']:,} nodes, {report['m']:,} edges")
+        print(f"  Average degree: {report['average_degree']:.2f}")
         
         return G
     
-    def _download_and_parse(self, dataset_name: str, use_cache: bool) -> nx.Graph:
-        """Download and parse graph from SNAP."""
+    def load_csr(self, dataset_name: str, use_cache: bool = True) -> Dict:
+        """
+        Load a SNAP graph as CSR arrays through the binary cache.
+        
+        The first call parses the edge list (self-loops and duplicate edges
+        dropped, no component extraction) and writes {dataset}.csr.bin;
+        later calls memory-map that file.
+        
+        Args:
+            dataset_name: Name of dataset (e.g., 'ca-GrQc')
+            use_cache: Use cached files if available
+            
+        Returns:
+            Dictionary with offsets, neighbors and raw_ids (SNAP node id of every vertex)
+        """
+        if dataset_name not in self.DATASETS:
+            raise ValueError(f"Unknown dataset: {dataset_name}\n"
+                           f"Available: {list(self.DATASETS.keys())}")
+        
+        csr_file = self.csr_cache_file(dataset_name)
+        if use_cache and os.path.exists(csr_file):
+            print(f"  Using cached CSR: {csr_file}")
+            return load_arrays(csr_file, mmap=True)
+        
+        edge_file = self._download(dataset_name, use_cache)
+        start = time.time()
+        offsets, neighbors, raw_ids = edge_file_to_csr(edge_file)
+        save_arrays(csr_file, {'offsets': offsets, 'neighbors': neighbors, 'raw_ids': raw_ids})
+        print(f"  ✓ Built CSR cache {csr_file} in {time.time() - start:.2f}s "
+              f"({len(raw_ids):,} nodes, {len(neighbors) // 2:,} edges)")
+        
+        return load_arrays(csr_file, mmap=True)
+    
+    def degree_bounds(self, dataset_name: str, use_cache: bool = True,
+                      multiplicity: int = 2, verbose: bool = True) -> Dict:
+        """
+        Quick degeneracy and dk bounds from the degree sequence alone.
+
+        Reads only the offsets of the binary CSR cache if it exists, otherwise
+        streams degree counts from the edge list. SNAP lists the edges of
+        undirected graphs in both directions, hence multiplicity 2.
+
+        Args:
+            dataset_name: Name of dataset (e.g., 'ca-GrQc')
+            use_cache: Use cached files if available
+            multiplicity: Times one edge may be listed in the edge file
+            verbose: Print the bounds
+
+        Returns:
+            Dictionary from degree_bounds.fast_bounds()
+        """
+        from degree_bounds import fast_bounds
+
+        if dataset_name not in self.DATASETS:
+            raise ValueError(f"Unknown dataset: {dataset_name}\n"
+                           f"Available: {list(self.DATASETS.keys())}")
+
+        csr_file = self.csr_cache_file(dataset_name)
+        if use_cache and os.path.exists(csr_file):
+            return fast_bounds(csr_file, verbose=verbose)
+        return fast_bounds(self._download(dataset_name, use_cache), multiplicity, verbose)
+
+    def stats(self, dataset_name: str, use_cache: bool = True, verbose: bool = True) -> Dict:
+        """
+        Statistics report of a dataset's CSR (see graph_stats.py).
+
+        The report is stored in the cache directory under the graph
+        fingerprint, so later calls skip the sweep.
+
+        Args:
+            dataset_name: Name of dataset (e.g., 'ca-GrQc')
+            use_cache: Use cached files if available
+            verbose: Print the report
+
+        Returns:
+            Dictionary from graph_stats.graph_stats()
+        """
+        csr = self.load_csr(dataset_name, use_cache)
+        return graph_stats(csr['offsets'], csr['neighbors'],
+                           cache_dir=self.cache_dir if use_cache else None, verbose=verbose)
+
+    def ingest(self, dataset_name: str, use_cache: bool = True, verbose: bool = True) -> Dict:
+        """
+        Build the dataset's caches and record measured statistics in the catalog.
+        
+        Times the CSR load (parse and build on the first call, opening the
+        cache afterwards) and a full peel, and records exact counts, max
+        degree, degeneracy and cache file sizes (see dataset_catalog.py).
+        
+        Args:
+            dataset_name: Name of dataset (e.g., 'ca-GrQc')
+            use_cache: Use cached files if available
+            verbose: Print the recorded entry
+            
+        Returns:
+            The catalog entry
+        """
+        from large_set_arboricity import _bucket_peel_csr
+        
+        builds = not (use_cache and os.path.exists(self.csr_cache_file(dataset_name)))
+        start = time.time()
+        csr = self.load_csr(dataset_name, use_cache)
+        load_seconds = time.time() - start
+        if builds:
+            self.catalog.record(dataset_name, csr_build_seconds=load_seconds)
+        
+        report = graph_stats(csr['offsets'], csr['neighbors'], cache_dir=self.cache_dir)
+        
+        # Compile for read-only (memory-mapped) arrays outside the timed peel
+        tiny_offsets = np.zeros(2, dtype=np.int64)
+        tiny_neighbors = np.zeros(0, dtype=np.int32)
+        tiny_offsets.flags.writeable = tiny_neighbors.flags.writeable = False
+        _bucket_peel_csr(tiny_offsets, tiny_neighbors)
+        
+        start = time.time()
+        degree_at_removal = _bucket_peel_csr(csr['offsets'], csr['neighbors'])[1]
+        peel_seconds = time.time() - start
+        
+        entry = self.catalog.record(
+            dataset_name,
+            n=report['n'],
+            m=report['m'],
+            largest_component=report['largest_component'],
+            largest_component_edges=report['largest_component_edges'],
+            max_degree=report['max_degree'],
+            degeneracy=int(degree_at_removal.max()) if len(degree_at_removal) > 0 else 0,
+            edge_file_bytes=os.path.getsize(self.edge_cache_file(dataset_name)),
+            csr_bytes=os.path.getsize(self.csr_cache_file(dataset_name)),
+            load_seconds=load_seconds,
+            peel_seconds=peel_seconds,
+            fingerprint=report['fingerprint'],
+        )
+        
+        if verbose:
+            print(f"✓ Ingested {dataset_name}: {entry['n']:,} nodes, {entry['m']:,} edges, "
+                  f"max degree {entry['max_degree']:,}, degeneracy {entry['degeneracy']}")
+            print(f"  Load {load_seconds:.2f}s, peel {peel_seconds:.2f}s, "
+                  f"CSR cache {entry['csr_bytes'] / 2**20:.1f} MB")
+        
+        return entry
+    
+    def csr_cache_file(self, dataset_name: str) -> str:
+        """Path of the binary CSR cache file of a dataset."""
+        return os.path.join(self.cache_dir, f'{dataset_name}.csr.bin')
+    
+    def edge_cache_file(self, dataset_name: str) -> str:
+        """Path of the cached compressed edge list of a dataset."""
+        return os.path.join(self.cache_dir, f'{dataset_name}.txt.gz')
+    
+    def _download(self, dataset_name: str, use_cache: bool) -> str:
+        """Make sure the compressed edge list is in the cache; return its path."""
         url = self.DATASETS[dataset_name]
-        cache_file = os.path.join(self.cache_dir, f'{dataset_name}.txt.gz')
+        cache_file = self.edge_cache_file(dataset_name)
         
         # Check cache
         if use_cache and os.path.exists(cache_file):
             print(f"  Using cached file: {cache_file}")
-            with gzip.open(cache_file, 'rt') as f:
-                return self._parse_snap_edgelist(f.read())
+            return cache_file
         
         # Download
         print(f"  Downloading from SNAP...")
@@ -166,11 +322,7 @@ class SNAPLoader:
                 f.write(compressed_data)
             print(f"  ✓ Downloaded and cached to {cache_file}")
             
-            # Parse
-            with gzip.GzipFile(fileobj=io.BytesIO(compressed_data)) as f:
-                content = f.read().decode('utf-8')
-            
-            return self._parse_snap_edgelist(content)
+            return cache_file
         
         except Exception as e:
             print(f"✗ Error downloading: {e}")
@@ -180,6 +332,12 @@ class SNAPLoader:
             print(f"3. Place file in: {self.cache_dir}/")
             raise
     
+    def _download_and_parse(self, dataset_name: str, use_cache: bool) -> nx.Graph:
+        """Download and parse graph from SNAP."""
+        cache_file = self._download(dataset_name, use_cache)
+        with gzip.open(cache_file, 'rt') as f:
+            return self._parse_snap_edgelist(f.read())
+    
     def _parse_snap_edgelist(self, text_content: str) -> nx.Graph:
         """Parse SNAP edge list format (lines with comments starting with #)."""
         G = nx.Graph()
@@ -201,8 +359,9 @@ class SNAPLoader:
         return G
     
     @classmethod
-    def list_datasets(cls) -> None:
-        """Print all available datasets."""
+    def list_datasets(cls, cache_dir: str = './snap_cache') -> None:
+        """Print all available datasets, with measured sizes where ingested."""
+        catalog = DatasetCatalog(os.path.join(cache_dir, 'catalog.json'))
         print("\nAvailable SNAP datasets:")
         print("-" * 80)
         
@@ -218,11 +377,11 @@ class SNAPLoader:
         for category, datasets in categories.items():
             print(f"\n{category}:")
             for name in datasets:
-                if name in cls.METADATA:
-                    meta = cls.METADATA[name]
-                    print(f"  {name:<20} n~{meta['n']:>7,}  m~{meta['m']:>9,}  {meta['desc']}")
+                entry = catalog.get(name)
+                if entry is not None:
+                    print(f"  {name:<20} n={entry['n']:>7,}  m={entry['m']:>9,}  {cls.DESCRIPTIONS[name]}")
                 else:
-                    print(f"  {name}")
+                    print(f"  {name:<20} {'(not ingested)':<24}  {cls.DESCRIPTIONS[name]}")
         
         print("\n" + "-" * 80)
         print(f"Total: {len(cls.DATASETS)} datasets available")
@@ -254,6 +413,7 @@ def list_snap_datasets() -> None:
 # Test/demo script
 if __name__ == '__main__':
     import sys
+    from triangles import clustering_networkx
     
     # Show available datasets
     if len(sys.argv) == 1:
@@ -284,14 +444,11 @@ if __name__ == '__main__':
         print("\n" + "="*80)
         print("GRAPH STATISTICS")
         print("="*80)
-        print(f"Nodes: {G.number_of_nodes():,}")
-        print(f"Edges: {G.number_of_edges():,}")
-        print(f"Average degree: {2*G.number_of_edges()/G.number_of_nodes():.2f}")
-        print(f"Density: {nx.density(G):.6f}")
-        print(f"Connected: {nx.is_connected(G)}")
-        
-        if G.number_of_nodes() <= 10000:
-            print(f"Clustering coefficient: {nx.average_clustering(G):.4f}")
+        print_graph_stats(graph_stats_networkx(G))
+        
+        stats = clustering_networkx(G)
+        print(f"Clustering coefficient: {stats['average_clustering']:.4f}")
+        print(f"Transitivity: {stats['transitivity']:.4f}")
         
         print("\n✓ Graph loaded successfully!")
         
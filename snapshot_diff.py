@@ -0,0 +1,701 @@
+#!/usr/bin/env python3
+"""
+Snapshot-diff analysis with warm-started peeling
+
+Successive snapshots of the same network (e.g. SNAP amazon0302 → amazon0312,
+soc-Slashdot0811 → soc-Slashdot0902) differ in a small fraction of edges.
+Instead of re-analysing each snapshot from scratch:
+
+1. Edge delta:  merge the sorted edge keys of the two cached CSR snapshots
+                (one linear pass gives removed, added and union edges)
+2. Coreness:    apply deletions, then insertions, one edge at a time with the
+                traversal algorithms of Sariyüce et al. (only the K-subcore
+                around each changed edge is visited)
+3. Peel:        a minimum-degree peel removes the k-shells in increasing
+                order, and the segment of shell K depends only on edges
+                incident to shell K. Shells touched by the delta are
+                re-peeled; every other shell reuses its segment of the
+                previous snapshot's peel unchanged
+4. Report:      changed coreness, d_0, dk breakpoints and the densest region
+
+The peel state of every analysed snapshot is cached next to its CSR
+({dataset}.peel.bin), so a chain of snapshots is processed diff by diff.
+
+Usage:
+    python snapshot_diff.py <old_dataset> <new_dataset>
+
+Example:
+    python snapshot_diff.py amazon0302 amazon0312
+"""
+
+import os
+import sys
+import time
+import numpy as np
+from numba import njit
+from typing import Dict, Tuple
+
+from graph_csr import edges_to_csr, csr_edge_keys, save_arrays, load_arrays
+from large_set_arboricity import _bucket_peel_csr, _compute_dk_from_states
+
+
+@njit(cache=True)
+def _merge_diff(a: np.ndarray, b: np.ndarray) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """
+    Sorted merge of two sorted key arrays.
+
+    Returns:
+        (union, in_a, in_b) where in_a / in_b flag membership of every union key
+    """
+    union = np.empty(len(a) + len(b), dtype=np.int64)
+    in_a = np.zeros(len(a) + len(b), dtype=np.bool_)
+    in_b = np.zeros(len(a) + len(b), dtype=np.bool_)
+    i = 0
+    j = 0
+    t = 0
+    while i < len(a) or j < len(b):
+        if j >= len(b) or (i < len(a) and a[i] < b[j]):
+            union[t] = a[i]
+            in_a[t] = True
+            i += 1
+        elif i >= len(a) or b[j] < a[i]:
+            union[t] = b[j]
+            in_b[t] = True
+            j += 1
+        else:
+            union[t] = a[i]
+            in_a[t] = True
+            in_b[t] = True
+            i += 1
+            j += 1
+        t += 1
+    return union[:t], in_a[:t], in_b[:t]
+
+
+@njit(cache=True)
+def _mcd(offsets, neighbors, edge_ids, present, core, w, K):
+    """Number of present neighbours of w with core ≥ K."""
+    c = 0
+    for idx in range(offsets[w], offsets[w + 1]):
+        if present[edge_ids[idx]] and core[neighbors[idx]] >= K:
+            c += 1
+    return c
+
+
+@njit(cache=True)
+def _pcd(offsets, neighbors, edge_ids, present, core, w, K, mcd_stamp, mcd_val, epoch):
+    """Neighbours of w with core > K, or core == K and MCD > K (MCD cached per epoch)."""
+    c = 0
+    for idx in range(offsets[w], offsets[w + 1]):
+        if not present[edge_ids[idx]]:
+            continue
+        y = neighbors[idx]
+        if core[y] > K:
+            c += 1
+        elif core[y] == K:
+            if mcd_stamp[y] != epoch:
+                mcd_stamp[y] = epoch
+                mcd_val[y] = _mcd(offsets, neighbors, edge_ids, present, core, y, K)
+            if mcd_val[y] > K:
+                c += 1
+    return c
+
+
+def _coreness_scratch(n: int) -> tuple:
+    """
+    Working arrays of _update_coreness_with() for an n-vertex graph.
+
+    The stamps are compared against a traversal epoch that keeps counting
+    across calls (state[0]), so one scratch tuple serves any number of
+    calls without being cleared.
+    """
+    return (np.zeros(n, dtype=np.int64),      # cd
+            np.zeros(n, dtype=np.int64),      # seen: epoch stamp, cd initialised / visited
+            np.zeros(n, dtype=np.int64),      # mark: epoch stamp, dismissed / evicted
+            np.zeros(n, dtype=np.int64),      # mcd_stamp
+            np.zeros(n, dtype=np.int64),      # mcd_val
+            np.zeros(n, dtype=np.int64),      # visit: epoch stamp, visited by insertion traversal
+            np.empty(n + 1, dtype=np.int64),  # stack
+            np.empty(n, dtype=np.int64),      # queue
+            np.empty(n, dtype=np.int64),      # visited_list
+            np.zeros(n, dtype=np.int64),      # logged: call stamp, already in changed
+            np.empty(n, dtype=np.int64),      # changed
+            np.zeros(3, dtype=np.int64))      # state: epoch, call, len(changed)
+
+
+def _update_coreness(offsets: np.ndarray, neighbors: np.ndarray, edge_ids: np.ndarray,
+                     edge_u: np.ndarray, edge_v: np.ndarray, present: np.ndarray,
+                     core: np.ndarray, deleted: np.ndarray, inserted: np.ndarray,
+                     budget: int) -> int:
+    """
+    Maintain core numbers under edge deletions then insertions.
+
+    present[e] must describe the old graph on entry; on return it describes
+    the new graph and core holds its core numbers.
+
+    Returns:
+        Number of vertices visited by the traversals, or -1 once more than
+        budget visits were needed (core and present are then unusable)
+    """
+    return _update_coreness_with(offsets, neighbors, edge_ids, edge_u, edge_v, present,
+                                 core, deleted, inserted, budget, _coreness_scratch(len(core)))
+
+
+@njit(cache=True)
+def _update_coreness_with(offsets: np.ndarray, neighbors: np.ndarray, edge_ids: np.ndarray,
+                          edge_u: np.ndarray, edge_v: np.ndarray, present: np.ndarray,
+                          core: np.ndarray, deleted: np.ndarray, inserted: np.ndarray,
+                          budget: int, scratch: tuple) -> int:
+    """
+    _update_coreness() on caller-owned working arrays (see _coreness_scratch()).
+
+    Nothing of size n is allocated or cleared, so a call costs only its
+    traversals. Every vertex whose core number is assigned is logged once
+    per call: changed[:state[2]] lists them afterwards (a superset of the
+    vertices whose core number differs, unless the call returned -1).
+    """
+    cd, seen, mark, mcd_stamp, mcd_val, visit, stack, queue, visited_list, \
+        logged, changed, state = scratch
+    state[1] += 1
+    call = state[1]
+    nchanged = 0
+    epoch = state[0]
+    work = 0
+
+    # Deletions: vertices of the K-subcore whose support drops below K fall to K-1
+    for e in deleted:
+        present[e] = False
+        u = edge_u[e]
+        v = edge_v[e]
+        K = min(core[u], core[v])
+        if K == 0:
+            continue
+        epoch += 1
+        qlen = 0
+        for r in (u, v):
+            if core[r] == K and seen[r] != epoch:
+                seen[r] = epoch
+                cd[r] = _mcd(offsets, neighbors, edge_ids, present, core, r, K)
+                work += 1
+                if cd[r] < K:
+                    mark[r] = epoch
+                    queue[qlen] = r
+                    qlen += 1
+        head = 0
+        while head < qlen:
+            w = queue[head]
+            head += 1
+            core[w] = K - 1
+            if logged[w] != call:
+                logged[w] = call
+                changed[nchanged] = w
+                nchanged += 1
+            for idx in range(offsets[w], offsets[w + 1]):
+                if not present[edge_ids[idx]]:
+                    continue
+                y = neighbors[idx]
+                if core[y] != K:
+                    continue
+                if seen[y] != epoch:
+                    # Fresh count already excludes w (its core just dropped)
+                    seen[y] = epoch
+                    cd[y] = _mcd(offsets, neighbors, edge_ids, present, core, y, K)
+                    work += 1
+                else:
+                    cd[y] -= 1
+                if cd[y] < K and mark[y] != epoch:
+                    mark[y] = epoch
+                    queue[qlen] = y
+                    qlen += 1
+        if work > budget:
+            state[0] = epoch
+            return -1
+
+    # Insertions: traverse the K-subcore from the root, evicting vertices
+    # whose potential support cannot exceed K; survivors rise to K+1
+    for e in inserted:
+        present[e] = True
+        u = edge_u[e]
+        v = edge_v[e]
+        K = min(core[u], core[v])
+        epoch += 1
+        nvis = 0
+
+        for r in (u, v):
+            if core[r] != K or visit[r] == epoch:
+                continue
+            sp = 0
+            stack[0] = r
+            if seen[r] != epoch:
+                seen[r] = epoch
+                cd[r] = 0
+            cd[r] += _pcd(offsets, neighbors, edge_ids, present, core, r, K,
+                          mcd_stamp, mcd_val, epoch)
+            visit[r] = epoch
+            visited_list[nvis] = r
+            nvis += 1
+
+            while sp >= 0:
+                w = stack[sp]
+                sp -= 1
+                if cd[w] > K:
+                    for idx in range(offsets[w], offsets[w + 1]):
+                        if not present[edge_ids[idx]]:
+                            continue
+                        y = neighbors[idx]
+                        if core[y] != K or visit[y] == epoch:
+                            continue
+                        if mcd_stamp[y] != epoch:
+                            mcd_stamp[y] = epoch
+                            mcd_val[y] = _mcd(offsets, neighbors, edge_ids, present, core, y, K)
+                        if mcd_val[y] <= K:
+                            continue
+                        # cd may already hold evictions seen before the visit
+                        if seen[y] != epoch:
+                            seen[y] = epoch
+                            cd[y] = 0
+                        cd[y] += _pcd(offsets, neighbors, edge_ids, present, core, y, K,
+                                      mcd_stamp, mcd_val, epoch)
+                        visit[y] = epoch
+                        visited_list[nvis] = y
+                        nvis += 1
+                        sp += 1
+                        stack[sp] = y
+                        if work + nvis > budget:
+                            state[0] = epoch
+                            return -1
+                elif mark[w] != epoch:
+                    # Propagate eviction
+                    mark[w] = epoch
+                    qlen = 1
+                    queue[0] = w
+                    head = 0
+                    while head < qlen:
+                        x = queue[head]
+                        head += 1
+                        for idx in range(offsets[x], offsets[x + 1]):
+                            if not present[edge_ids[idx]]:
+                                continue
+                            y = neighbors[idx]
+                            if core[y] != K:
+                                continue
+                            if seen[y] != epoch:
+                                seen[y] = epoch
+                                cd[y] = 0
+                            cd[y] -= 1
+                            if cd[y] == K and visit[y] == epoch and mark[y] != epoch:
+                                mark[y] = epoch
+                                queue[qlen] = y
+                                qlen += 1
+
+        work += nvis
+        for t in range(nvis):
+            w = visited_list[t]
+            if mark[w] != epoch:
+                core[w] = K + 1
+                if logged[w] != call:
+                    logged[w] = call
+                    changed[nchanged] = w
+                    nchanged += 1
+        if work > budget:
+            state[0] = epoch
+            return -1
+
+    state[0] = epoch
+    state[2] = nchanged
+    return work
+
+
+@njit(cache=True)
+def _peel_shells(offsets: np.ndarray, neighbors: np.ndarray, edge_ids: np.ndarray,
+                 present: np.ndarray, core: np.ndarray,
+                 shell_vertices: np.ndarray, shell_starts: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Minimum-degree peel of selected k-shells, each on its own.
+
+    Shell K sees every vertex of core < K removed and every vertex of core > K
+    still present, so a vertex's degree is its number of present neighbours
+    with core ≥ K and only removals inside the shell decrement it. The
+    minimum stays ≤ K while the shell is non-empty, so degrees above K share
+    one overflow bucket.
+
+    Args:
+        shell_vertices: Vertices of the selected shells, grouped by shell
+        shell_starts: Group boundaries (len = number of shells + 1)
+
+    Returns:
+        (order, degree_at_removal) concatenated over the shells
+    """
+    n = len(core)
+    total = len(shell_vertices)
+    order = np.empty(total, dtype=np.int32)
+    degree_at_removal = np.empty(total, dtype=np.int32)
+    degrees = np.zeros(n, dtype=np.int64)
+    removed = np.zeros(n, dtype=np.bool_)
+    nxt = np.full(n, -1, dtype=np.int64)
+    prv = np.full(n, -1, dtype=np.int64)
+    out = 0
+
+    for s in range(len(shell_starts) - 1):
+        lo = shell_starts[s]
+        hi = shell_starts[s + 1]
+        if lo == hi:
+            continue
+        K = core[shell_vertices[lo]]
+        head = np.full(K + 2, -1, dtype=np.int64)
+
+        for t in range(hi - 1, lo - 1, -1):
+            v = shell_vertices[t]
+            d = 0
+            for idx in range(offsets[v], offsets[v + 1]):
+                if present[edge_ids[idx]] and core[neighbors[idx]] >= K:
+                    d += 1
+            degrees[v] = d
+            b = min(d, K + 1)
+            prv[v] = -1
+            nxt[v] = head[b]
+            if head[b] >= 0:
+                prv[head[b]] = v
+            head[b] = v
+
+        d = 0
+        for _ in range(hi - lo):
+            while head[d] < 0:
+                d += 1
+            v = head[d]
+            head[d] = nxt[v]
+            if nxt[v] >= 0:
+                prv[nxt[v]] = -1
+            removed[v] = True
+            order[out] = v
+            degree_at_removal[out] = degrees[v]
+            out += 1
+
+            for idx in range(offsets[v], offsets[v + 1]):
+                if not present[edge_ids[idx]]:
+                    continue
+                u = neighbors[idx]
+                if core[u] != K or removed[u]:
+                    continue
+                bu = min(degrees[u], K + 1)
+                degrees[u] -= 1
+                nb = min(degrees[u], K + 1)
+                if nb == bu:
+                    continue
+                if prv[u] >= 0:
+                    nxt[prv[u]] = nxt[u]
+                else:
+                    head[bu] = nxt[u]
+                if nxt[u] >= 0:
+                    prv[nxt[u]] = prv[u]
+                prv[u] = -1
+                nxt[u] = head[nb]
+                if head[nb] >= 0:
+                    prv[head[nb]] = u
+                head[nb] = u
+
+            if d > 0:
+                d -= 1
+
+    return order, degree_at_removal
+
+
+def peel_state(offsets: np.ndarray, neighbors: np.ndarray) -> Dict[str, np.ndarray]:
+    """
+    Full minimum-degree peel of one snapshot, in the layout cached as {dataset}.peel.bin.
+
+    Returns:
+        Dictionary with order, degree_at_removal and coreness
+    """
+    order, degree_at_removal, _, _, coreness = _bucket_peel_csr(offsets, neighbors)
+    return {'order': order, 'degree_at_removal': degree_at_removal, 'coreness': coreness}
+
+
+def state_profile(state: Dict[str, np.ndarray], m: int) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """
+    Rebuild the recorded peel states of a cached peel and its dk profile.
+
+    Args:
+        state: Peel state (order, degree_at_removal, coreness)
+        m: Number of edges of the snapshot
+
+    Returns:
+        (vertices_at_step, edges_at_step, dk_values)
+    """
+    n = len(state['order'])
+    vertices_at_step = np.arange(n, 0, -1, dtype=np.int32)
+    removed = np.cumsum(state['degree_at_removal'], dtype=np.int64)
+    edges_at_step = (m - np.concatenate(([0], removed[:-1]))).astype(np.int32)
+    dk_values = _compute_dk_from_states(vertices_at_step, edges_at_step, n)
+    return vertices_at_step, edges_at_step, dk_values
+
+
+def _densest_suffix(state: Dict[str, np.ndarray], vertices_at_step: np.ndarray,
+                    edges_at_step: np.ndarray) -> Tuple[np.ndarray, float]:
+    """Peel suffix with the highest average degree (the region that sets d_0)."""
+    if len(vertices_at_step) == 0:
+        return np.zeros(0, dtype=np.int32), 0.0
+    avg = 2.0 * edges_at_step / vertices_at_step
+    step = int(np.argmax(avg))
+    return np.asarray(state['order'][step:]), float(avg[step])
+
+
+def _breakpoints(dk_values: np.ndarray) -> np.ndarray:
+    """Values of k at which d_k drops (d_k < d_{k-1})."""
+    return np.flatnonzero(np.diff(dk_values) < 0) + 1
+
+
+def diff_snapshots(old_csr: Dict[str, np.ndarray], old_state: Dict[str, np.ndarray],
+                   new_csr: Dict[str, np.ndarray], budget_factor: float = 1.0,
+                   verbose: bool = True) -> Tuple[Dict[str, np.ndarray], dict]:
+    """
+    Warm-start the peel of a new snapshot from the peel of the previous one.
+
+    Subcore traversals can cover whole shells on graphs with few distinct
+    core values (e.g. Erdős–Rényi). Once they visit more than
+    budget_factor·n vertices, coreness is recomputed with one O(n + m) peel
+    instead; shell reuse still applies.
+
+    Args:
+        old_csr: Previous snapshot (offsets, neighbors, raw_ids)
+        old_state: Peel state of the previous snapshot (see peel_state())
+        new_csr: New snapshot (offsets, neighbors, raw_ids)
+        budget_factor: Traversal budget in multiples of the vertex count
+        verbose: Print the report
+
+    Returns:
+        (new_state, report) where new_state is in the layout of peel_state()
+    """
+    timings = {}
+    start_time = time.time()
+
+    # Step 1: edge delta in the union id space (relabelling preserves order)
+    old_raw = np.asarray(old_csr['raw_ids'], dtype=np.int64)
+    new_raw = np.asarray(new_csr['raw_ids'], dtype=np.int64)
+    union_raw = np.union1d(old_raw, new_raw)
+    old_to_union = np.searchsorted(union_raw, old_raw)
+    new_to_union = np.searchsorted(union_raw, new_raw)
+    N = len(union_raw)
+
+    old_keys = csr_edge_keys(old_csr['offsets'], old_csr['neighbors'], old_to_union)
+    new_keys = csr_edge_keys(new_csr['offsets'], new_csr['neighbors'], new_to_union)
+    keys, in_old, in_new = _merge_diff(old_keys, new_keys)
+    deleted = np.flatnonzero(in_old & ~in_new)
+    inserted = np.flatnonzero(in_new & ~in_old)
+
+    edge_u = (keys >> 32).astype(np.int32)
+    edge_v = (keys & 0xFFFFFFFF).astype(np.int32)
+    offsets, neighbors, edge_ids = edges_to_csr(np.stack((edge_u, edge_v), axis=1), N,
+                                                with_edge_ids=True)
+    timings['delta'] = time.time() - start_time
+
+    # Step 2: coreness maintenance
+    step_time = time.time()
+    old_core = np.zeros(N, dtype=np.int64)
+    old_core[old_to_union] = old_state['coreness']
+    core = old_core.copy()
+    present = in_old.copy()
+    visited = _update_coreness(offsets, neighbors, edge_ids, edge_u, edge_v,
+                               present, core, deleted, inserted, int(budget_factor * N))
+    if visited < 0:
+        present = in_new.copy()
+        new_edges = np.stack((edge_u[in_new], edge_v[in_new]), axis=1)
+        _, _, _, _, coreness = _bucket_peel_csr(*edges_to_csr(new_edges, N))
+        core = coreness.astype(np.int64)
+    timings['coreness'] = time.time() - step_time
+
+    # Step 3: dirty shells are re-peeled, clean shells keep their old segment
+    step_time = time.time()
+    max_core = int(max(core.max(initial=0), old_core.max(initial=0)))
+    dirty = np.zeros(max_core + 2, dtype=bool)
+    changed = np.flatnonzero(core != old_core)
+    lo = np.minimum(core[changed], old_core[changed])
+    hi = np.maximum(core[changed], old_core[changed])
+    for a, b in zip(lo, hi):
+        dirty[a:b + 1] = True
+    delta = np.concatenate((deleted, inserted))
+    dirty[np.minimum(old_core[edge_u[delta]], old_core[edge_v[delta]])] = True
+    dirty[np.minimum(core[edge_u[delta]], core[edge_v[delta]])] = True
+    # Vertices that left the snapshot are isolated in the union: shell 0
+    if len(new_raw) < N:
+        dirty[0] = True
+
+    shells = np.flatnonzero(dirty[:max_core + 1])
+    by_core = np.argsort(core, kind='stable')
+    bounds = np.searchsorted(core[by_core], np.arange(max_core + 2))
+    shell_vertices = np.concatenate([by_core[bounds[K]:bounds[K + 1]] for K in shells]) \
+        if len(shells) > 0 else np.zeros(0, dtype=np.int64)
+    shell_starts = np.zeros(len(shells) + 1, dtype=np.int64)
+    np.cumsum(bounds[shells + 1] - bounds[shells], out=shell_starts[1:])
+    peeled_order, peeled_degree = _peel_shells(offsets, neighbors, edge_ids, present, core,
+                                               shell_vertices, shell_starts)
+
+    # The old order removes shells in increasing core: slice it per shell
+    old_order = old_to_union[np.asarray(old_state['order'])]
+    old_degree = np.asarray(old_state['degree_at_removal'])
+    old_bounds = np.searchsorted(old_core[old_order], np.arange(max_core + 2))
+
+    order_parts = []
+    degree_parts = []
+    shell_index = np.full(max_core + 1, -1, dtype=np.int64)
+    shell_index[shells] = np.arange(len(shells))
+    for K in range(max_core + 1):
+        if dirty[K]:
+            i = shell_index[K]
+            order_parts.append(peeled_order[shell_starts[i]:shell_starts[i + 1]])
+            degree_parts.append(peeled_degree[shell_starts[i]:shell_starts[i + 1]])
+        else:
+            order_parts.append(old_order[old_bounds[K]:old_bounds[K + 1]])
+            degree_parts.append(old_degree[old_bounds[K]:old_bounds[K + 1]])
+    order = np.concatenate(order_parts).astype(np.int64)
+    degree_at_removal = np.concatenate(degree_parts).astype(np.int32)
+
+    # Map back to new snapshot ids, dropping vertices that left
+    union_to_new = np.full(N, -1, dtype=np.int64)
+    union_to_new[new_to_union] = np.arange(len(new_raw))
+    keep = union_to_new[order] >= 0
+    new_state = {
+        'order': union_to_new[order[keep]].astype(np.int32),
+        'degree_at_removal': degree_at_removal[keep],
+        'coreness': core[new_to_union].astype(np.int32),
+    }
+    timings['peel'] = time.time() - step_time
+
+    # Step 4: report
+    step_time = time.time()
+    old_m = len(old_keys)
+    new_m = len(new_keys)
+    _, _, old_dk = state_profile(old_state, old_m)
+    new_V, new_E, new_dk = state_profile(new_state, new_m)
+    old_V, old_E, _ = state_profile(old_state, old_m)
+    _, old_density = _densest_suffix(old_state, old_V, old_E)
+    dense_region, new_density = _densest_suffix(new_state, new_V, new_E)
+    timings['report'] = time.time() - step_time
+
+    both = np.zeros(N, dtype=bool)
+    both[old_to_union] = True
+    in_new_vertex = np.zeros(N, dtype=bool)
+    in_new_vertex[new_to_union] = True
+    kept_changed = changed[both[changed] & in_new_vertex[changed]]
+
+    report = {
+        'edges_added': len(inserted),
+        'edges_removed': len(deleted),
+        'vertices_added': int((in_new_vertex & ~both).sum()),
+        'vertices_removed': int((both & ~in_new_vertex).sum()),
+        'core_increased': int((core[kept_changed] > old_core[kept_changed]).sum()),
+        'core_decreased': int((core[kept_changed] < old_core[kept_changed]).sum()),
+        'traversal_visits': int(visited),
+        'coreness_recomputed': bool(visited < 0),
+        'max_core_old': int(old_core.max(initial=0)),
+        'max_core_new': int(core.max(initial=0)),
+        'dirty_shells': int(len(shells)),
+        'reused_shells': int(((np.diff(bounds[:max_core + 2]) > 0) & ~dirty[:max_core + 1]).sum()),
+        'repeeled_vertices': int(len(shell_vertices)),
+        'd0_old': int(old_dk[0]) if len(old_dk) > 0 else 0,
+        'd0_new': int(new_dk[0]) if len(new_dk) > 0 else 0,
+        'dk_breakpoints_old': _breakpoints(old_dk),
+        'dk_breakpoints_new': _breakpoints(new_dk),
+        'densest_avg_degree_old': old_density,
+        'densest_avg_degree_new': new_density,
+        'dense_region_raw_ids': new_raw[dense_region],
+        'timings': timings,
+        'time': time.time() - start_time,
+    }
+
+    if verbose:
+        print_report(report)
+
+    return new_state, report
+
+
+def print_report(report: dict) -> None:
+    """Print a snapshot-diff report."""
+    print(f"\n{'='*70}")
+    print("SNAPSHOT DIFF")
+    print(f"{'='*70}")
+    print(f"Edges:     +{report['edges_added']:,} / -{report['edges_removed']:,}")
+    print(f"Vertices:  +{report['vertices_added']:,} / -{report['vertices_removed']:,}")
+    if report['coreness_recomputed']:
+        how = "recomputed, traversal budget exceeded"
+    else:
+        how = f"{report['traversal_visits']:,} traversal visits"
+    print(f"Coreness:  {report['core_increased']:,} increased, "
+          f"{report['core_decreased']:,} decreased ({how})")
+    print(f"Max core:  {report['max_core_old']} → {report['max_core_new']}")
+    print(f"Shells:    {report['dirty_shells']} re-peeled "
+          f"({report['repeeled_vertices']:,} vertices), {report['reused_shells']} reused")
+    print(f"d_0:       {report['d0_old']} → {report['d0_new']}")
+    print(f"Densest suffix avg degree: {report['densest_avg_degree_old']:.3f} → "
+          f"{report['densest_avg_degree_new']:.3f} "
+          f"({len(report['dense_region_raw_ids']):,} vertices)")
+
+    old_bp = set(report['dk_breakpoints_old'].tolist())
+    new_bp = set(report['dk_breakpoints_new'].tolist())
+    print(f"d_k breakpoints: {len(old_bp)} → {len(new_bp)} "
+          f"({len(new_bp - old_bp)} new, {len(old_bp - new_bp)} gone)")
+
+    t = report['timings']
+    print(f"\nTimings: delta {t['delta']:.3f}s, coreness {t['coreness']:.3f}s, "
+          f"peel {t['peel']:.3f}s, report {t['report']:.3f}s "
+          f"(total {report['time']:.3f}s)")
+
+
+def load_or_build_peel_state(csr: Dict[str, np.ndarray], path: str) -> Dict[str, np.ndarray]:
+    """
+    Open the cached peel state of a snapshot, peeling it from scratch if missing.
+
+    Args:
+        csr: Snapshot CSR (offsets, neighbors)
+        path: Peel state cache file ({dataset}.peel.bin)
+
+    Returns:
+        Peel state (order, degree_at_removal, coreness)
+    """
+    if os.path.exists(path):
+        print(f"  Using cached peel state: {path}")
+        return load_arrays(path, mmap=True)
+
+    start = time.time()
+    state = peel_state(csr['offsets'], csr['neighbors'])
+    save_arrays(path, state)
+    print(f"  ✓ Peeled from scratch in {time.time() - start:.2f}s, cached {path}")
+    return state
+
+
+def analyze_snapshot_pair(old_name: str, new_name: str, cache_dir: str = './snap_cache') -> dict:
+    """
+    Analyse a new SNAP snapshot as a diff against an older one.
+
+    Args:
+        old_name: Earlier dataset (e.g., 'amazon0302')
+        new_name: Later dataset (e.g., 'amazon0312')
+        cache_dir: SNAP cache directory
+
+    Returns:
+        Snapshot-diff report (see diff_snapshots())
+    """
+    from snap_api import SNAPLoader
+
+    loader = SNAPLoader(cache_dir)
+    print(f"Loading {old_name}...")
+    old_csr = loader.load_csr(old_name)
+    old_state = load_or_build_peel_state(old_csr, os.path.join(cache_dir, f'{old_name}.peel.bin'))
+
+    print(f"Loading {new_name}...")
+    new_csr = loader.load_csr(new_name)
+
+    new_state, report = diff_snapshots(old_csr, old_state, new_csr)
+    save_arrays(os.path.join(cache_dir, f'{new_name}.peel.bin'), new_state)
+    return report
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        print("Usage:")
+        print("  python snapshot_diff.py <old_dataset> <new_dataset>")
+        print("\nExample:")
+        print("  python snapshot_diff.py amazon0302 amazon0312")
+        sys.exit(0)
+
+    analyze_snapshot_pair(sys.argv[1], sys.argv[2])
@@ -6,6 +6,7 @@ the correctness of the 2-approximation algorithm.
 """
 
 import networkx as nx
+import numpy as np
 import sys
 from large_set_arboricity import LargeSetArboricity, demonstrate_algorithm
 
@@ -135,6 +136,1390 @@ def test_edge_cases():
         print(f"  ✗ FAIL: {e}")
 
 
+def test_top_t_dense_subgraphs():
+    """Test top-t vertex-disjoint witness extraction."""
+    print("\n" + "="*70)
+    print("TEST 4: Top-t Dense Subgraphs")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+
+    # Disjoint K10, K8, K6 joined by a path: the cliques come out densest first
+    G = nx.disjoint_union_all([nx.complete_graph(10), nx.complete_graph(8),
+                               nx.complete_graph(6), nx.path_graph(5)])
+    G.add_edges_from([(9, 10), (17, 18), (23, 24)])
+    lsa = LargeSetArboricityIgraph.from_networkx(G)
+    witnesses = lsa.compute_top_t_dense_subgraphs(3)
+
+    print("\nTest 4.1: Witnesses are the cliques, densest first")
+    sizes = [len(w) for w, _ in witnesses]
+    averages = [round(avg, 6) for _, avg in witnesses]
+    print(f"  Sizes: {sizes}, average degrees: {averages}")
+    print(f"  ✓ PASS" if sizes == [10, 8, 6] and averages == [9.0, 7.0, 5.0] else f"  ✗ FAIL")
+
+    print("\nTest 4.2: Witnesses are vertex-disjoint and match their reported density")
+    seen = set()
+    ok = True
+    for w, avg in witnesses:
+        members = set(int(v) for v in w)
+        ok &= not (members & seen)
+        seen |= members
+        H = G.subgraph(members)
+        ok &= abs(2.0 * H.number_of_edges() / H.number_of_nodes() - avg) < 1e-9
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 4.3: First witness is the densest peel suffix with more than k vertices")
+    G = nx.gnm_random_graph(200, 1200, seed=7)
+    lsa = LargeSetArboricityIgraph.from_networkx(G)
+    k = 20
+    (first, avg), *_ = lsa.compute_top_t_dense_subgraphs(2, k=k)
+    _, _, vertices_at_step, edges_at_step, _ = lsa.peel_csr()
+    valid = vertices_at_step > k
+    best = float((2.0 * edges_at_step[valid] / vertices_at_step[valid]).max())
+    print(f"  |W|={len(first)}, d̄={avg:.4f}, densest suffix {best:.4f}")
+    print(f"  ✓ PASS" if len(first) > k and abs(avg - best) < 1e-9 else f"  ✗ FAIL")
+
+    print("\nTest 4.4: Shrinking remainders keep global ids (cliques K3..K40, shuffled ids)")
+    G = nx.disjoint_union_all([nx.complete_graph(s) for s in range(3, 41)])
+    perm = np.random.default_rng(4).permutation(G.number_of_nodes())
+    edges = [(int(perm[u]), int(perm[v])) for u, v in G.edges()]
+    G = nx.Graph()
+    G.add_nodes_from(range(len(perm)))
+    G.add_edges_from(edges)
+    lsa = LargeSetArboricityIgraph.from_networkx(G)
+    witnesses = lsa.compute_top_t_dense_subgraphs(100)
+    ok = [len(w) for w, _ in witnesses] == list(range(40, 2, -1))
+    for w, avg in witnesses:
+        H = G.subgraph(int(v) for v in w)
+        ok &= avg == len(w) - 1 and H.number_of_edges() == len(w) * (len(w) - 1) // 2
+    print(f"  {len(witnesses)} witnesses {'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def _max_subgraph_density(G):
+    """max over nonempty H ⊆ G of ⌈|E(H)| / |V(H)|⌉, by enumeration (small graphs only)."""
+    from itertools import combinations
+    nodes = list(G.nodes())
+    best = 0
+    for size in range(1, len(nodes) + 1):
+        for S in combinations(nodes, size):
+            e = G.subgraph(S).number_of_edges()
+            best = max(best, -(-e // size))
+    return best
+
+
+def test_pseudoarboricity():
+    """Test pseudoarboricity against brute-force densest subgraphs."""
+    print("\n" + "="*70)
+    print("TEST 5: Pseudoarboricity")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+
+    print("\nTest 5.1: p(G) = max ⌈|E(H)|/|V(H)|⌉ and the orientation achieves it")
+    cases = [("K6", nx.complete_graph(6)), ("Petersen", nx.petersen_graph()),
+             ("Wheel W9", nx.wheel_graph(9))]
+    cases += [(f"G(11, {m}) seed {s}", nx.gnm_random_graph(11, m, seed=s))
+              for s, m in ((1, 15), (2, 25), (3, 40))]
+    for name, G in cases:
+        p, oriented = LargeSetArboricityIgraph.from_networkx(G).compute_pseudoarboricity()
+        expected = _max_subgraph_density(G)
+        same_edges = {frozenset(e) for e in map(tuple, oriented)} == {frozenset(e) for e in G.edges()}
+        out_max = int(np.bincount(oriented[:, 0], minlength=G.number_of_nodes()).max()) if len(oriented) else 0
+        ok = p == expected and same_edges and out_max == p
+        print(f"  {name}: p={p}, expected {expected}, max out-degree {out_max} "
+              f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def test_h_partition():
+    """Test the H-partition invariants."""
+    print("\n" + "="*70)
+    print("TEST 6: H-partition")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+
+    print("\nTest 6.1: Every vertex has ≤ (2+ε)·α neighbours in its own or later layers")
+    for name, G in [("BA(500, 4)", nx.barabasi_albert_graph(500, 4, seed=1)),
+                    ("G(400, 3000)", nx.gnm_random_graph(400, 3000, seed=2)),
+                    ("Grid 20x20", nx.convert_node_labels_to_integers(nx.grid_2d_graph(20, 20)))]:
+        lsa = LargeSetArboricityIgraph.from_networkx(G)
+        result = lsa.compute_h_partition(epsilon=0.1)
+        layer = result['layers']
+        forward = [sum(1 for u in G[v] if layer[u] >= layer[v]) for v in G]
+        p, _ = lsa.compute_pseudoarboricity()
+        ok = (layer.min() >= 0 and max(forward) <= result['threshold']
+              and p <= result['arboricity_estimate'] <= result['threshold'])
+        print(f"  {name}: {result['num_layers']} layers, max forward degree {max(forward)} "
+              f"≤ {result['threshold']}, p={p} ≤ estimate {result['arboricity_estimate']} "
+              f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def test_sharded_peel():
+    """Test sharded approximate peeling against the single-process rounds."""
+    print("\n" + "="*70)
+    print("TEST 7: Sharded Approximate Peeling")
+    print("="*70)
+
+    from graph_csr import networkx_to_csr
+    from approximate_peel import approximate_peel_states
+    from sharded_peel import sharded_peel_states
+
+    G = nx.barabasi_albert_graph(3000, 5, seed=3)
+    offsets, neighbors = networkx_to_csr(G)[:2]
+    V, E, _ = approximate_peel_states(offsets, neighbors, 0.1)
+
+    print("\nTest 7.1: Same (vertices, edges) after every round")
+    rng = np.random.default_rng(0)
+    for name, owner in [("contiguous", None),
+                        ("random owners", rng.integers(0, 3, size=len(offsets) - 1).astype(np.int32))]:
+        V_s, E_s, stats = sharded_peel_states(offsets, neighbors, num_shards=3, epsilon=0.1, owner=owner)
+        ok = np.array_equal(V, V_s) and np.array_equal(E, E_s)
+        print(f"  {name}: {stats['rounds']} rounds, {stats['cross_shard_decrements']:,} "
+              f"cross-shard decrements {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 7.2: A failing worker surfaces its own error, not a broken pipe")
+    from sharded_peel import build_shards, ShardWorkerError
+    owner = (np.arange(len(offsets) - 1) * 3 // (len(offsets) - 1)).astype(np.int32)
+    shards = build_shards(offsets, neighbors, owner, 3)
+    mid_round = dict(shards[2], ghost_owner=shards[2]['ghost_owner'][:1])
+    hard_exit = dict(shards[1], vertices=_ExitOnLen())
+    for name, bad, expected in [("missing shard file", [shards[0], "/nonexistent/shard.bin", shards[2]],
+                                 "FileNotFoundError"),
+                                ("error in a round", shards[:2] + [mid_round], "IndexError"),
+                                ("hard exit", [shards[0], hard_exit, shards[2]], "exited with code 3")]:
+        try:
+            sharded_peel_states(None, None, epsilon=0.1, shards=bad)
+            ok = False
+        except ShardWorkerError as e:
+            ok = expected in str(e)
+        print(f"  {name}: {'✓ PASS' if ok else '✗ FAIL'}")
+
+
+class _ExitOnLen:
+    """Shard field that kills its worker process when touched."""
+
+    def __len__(self):
+        import os
+        os._exit(3)
+
+
+def test_graph_partition():
+    """Test the streaming partitioner on an edge file with sparse 64-bit ids."""
+    print("\n" + "="*70)
+    print("TEST 8: Streaming Partitioner")
+    print("="*70)
+
+    import os
+    import tempfile
+    from graph_csr import networkx_to_csr, load_arrays
+    from graph_partition import partition_edge_file, shard_paths
+    from approximate_peel import approximate_peel_states
+    from sharded_peel import sharded_peel_states
+    from degree_bounds import degree_sequence_from_edge_file
+
+    G = nx.barabasi_albert_graph(2000, 4, seed=5)
+    rng = np.random.default_rng(5)
+    raw = rng.choice(np.int64(1) << 62, size=G.number_of_nodes(), replace=False)
+    G_raw = nx.relabel_nodes(G, {v: int(raw[v]) for v in G})
+
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, 'edges.txt')
+        with open(path, 'w') as f:
+            f.write("# hashed ids\n")
+            for u, v in G_raw.edges():
+                f.write(f"{u} {v}\n")
+
+        for method in ('ldg', 'fennel'):
+            out = os.path.join(tmp, method)
+            result = partition_edge_file(path, out, num_shards=3, method=method, verbose=False)
+            ids = load_arrays(os.path.join(out, 'vertex_ids.bin'), mmap=False)
+            shards = [load_arrays(p, mmap=False) for p in shard_paths(out)]
+
+            print(f"\nTest 8.1 ({method}): ids, ownership and edges survive the round trip")
+            owned = np.sort(np.concatenate([sh['vertices'] for sh in shards]))
+            ok = (result['n'] == G.number_of_nodes() and result['m'] == G.number_of_edges()
+                  and set(ids['raw_ids'].tolist()) == set(G_raw.nodes())
+                  and np.array_equal(owned, np.arange(result['n'])))
+            print(f"  n={result['n']}, m={result['m']}, cut {result['edge_cut_fraction']:.1%} "
+                  f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+            print(f"\nTest 8.2 ({method}): sharded peel from the shard files matches one process")
+            index = {int(r): i for i, r in enumerate(ids['raw_ids'])}
+            H = nx.Graph()
+            H.add_nodes_from(range(result['n']))
+            H.add_edges_from((index[u], index[v]) for u, v in G_raw.edges())
+            offsets, neighbors = networkx_to_csr(H)[:2]
+            V, E, _ = approximate_peel_states(offsets, neighbors, 0.1)
+            V_s, E_s, _ = sharded_peel_states(None, None, epsilon=0.1, shards=shard_paths(out))
+            print(f"  ✓ PASS" if np.array_equal(V, V_s) and np.array_equal(E, E_s) else f"  ✗ FAIL")
+
+        print("\nTest 8.3: Degree sequence from the edge file with 64-bit ids")
+        degrees = degree_sequence_from_edge_file(path)
+        expected = sorted(d for _, d in G_raw.degree())
+        print(f"  ✓ PASS" if sorted(degrees.tolist()) == expected else f"  ✗ FAIL")
+
+
+def test_peel_engines():
+    """Test that the heap, Numba and prefetch engines agree."""
+    print("\n" + "="*70)
+    print("TEST 9: Peel Engines")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+
+    print("\nTest 9.1: Every engine gives the same dk profile, and compute_dk(k) agrees")
+    for name, G in [("BA(1500, 6)", nx.barabasi_albert_graph(1500, 6, seed=9)),
+                    ("G(800, 6000)", nx.gnm_random_graph(800, 6000, seed=9)),
+                    ("Caveman 20x8", nx.connected_caveman_graph(20, 8))]:
+        profiles = {}
+        for engine in LargeSetArboricityIgraph.ENGINES:
+            lsa = LargeSetArboricityIgraph.from_networkx(G, engine=engine)
+            profiles[engine] = lsa.compute_all_dk_optimized(verbose=False)[1]
+        reference = profiles['heap']
+        ok = all(np.array_equal(reference, dk) for dk in profiles.values())
+        ok &= all(lsa.compute_dk(k) == reference[k] for k in (0, 5, 50, len(G) // 2))
+        print(f"  {name}: d0={int(reference[0])}, engines {list(profiles)} "
+              f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 9.2: compute_coreness matches networkx core numbers")
+    G = nx.barabasi_albert_graph(1500, 6, seed=9)
+    core = LargeSetArboricityIgraph.from_networkx(G, engine='numba').compute_coreness()
+    expected = nx.core_number(G)
+    print(f"  ✓ PASS" if all(core[v] == expected[v] for v in G) else f"  ✗ FAIL")
+
+
+def _snapshot_csr(G):
+    """CSR dict (offsets, neighbors, raw_ids) of a graph with integer labels, ids ascending."""
+    from graph_csr import networkx_to_csr
+    H = nx.Graph()
+    H.add_nodes_from(sorted(G.nodes()))
+    H.add_edges_from(G.edges())
+    offsets, neighbors, nodes = networkx_to_csr(H)
+    return {'offsets': offsets, 'neighbors': neighbors, 'raw_ids': np.array(nodes, dtype=np.int64)}
+
+
+def _is_min_degree_peel(offsets, neighbors, order, degree_at_removal):
+    """Every step removes a vertex of minimum current degree, with that degree recorded."""
+    degrees = np.diff(offsets)
+    alive = np.ones(len(degrees), dtype=bool)
+    if len(order) != len(degrees):
+        return False
+    for v, d in zip(order, degree_at_removal):
+        if not alive[v] or degrees[v] != d or d != degrees[alive].min():
+            return False
+        alive[v] = False
+        nbrs = neighbors[offsets[v]:offsets[v + 1]]
+        np.subtract.at(degrees, nbrs[alive[nbrs]], 1)
+    return True
+
+
+def test_snapshot_diff():
+    """Test warm-started snapshot diffs against a peel of the new snapshot."""
+    print("\n" + "="*70)
+    print("TEST 10: Snapshot Diff")
+    print("="*70)
+
+    from snapshot_diff import diff_snapshots, peel_state, state_profile
+
+    rng = np.random.default_rng(10)
+    # Cliques K12..K20 far from the edited ids: their shells are reused
+    G_old = nx.barabasi_albert_graph(3000, 5, seed=10)
+    for size in range(12, 21):
+        G_old.add_edges_from(nx.complete_graph(range(5000 + 100 * size, 5000 + 100 * size + size)).edges())
+    for name, budget in [("traversal", 1.0), ("peel fallback", 0.0)]:
+        G_new = G_old.copy()
+        edges = list(G_new.edges())
+        G_new.remove_edges_from(edges[i] for i in rng.choice(len(edges), 20, replace=False))
+        G_new.add_edges_from((int(u), int(v)) for u, v in rng.integers(0, 3010, size=(20, 2)) if u != v)
+
+        old_csr = _snapshot_csr(G_old)
+        new_csr = _snapshot_csr(G_new)
+        old_state = peel_state(old_csr['offsets'], old_csr['neighbors'])
+        new_state, report = diff_snapshots(old_csr, old_state, new_csr,
+                                           budget_factor=budget, verbose=False)
+
+        print(f"\nTest 10.1 ({name}): coreness equals networkx core numbers of the new snapshot")
+        core = nx.core_number(G_new)
+        expected = np.array([core[int(r)] for r in new_csr['raw_ids']])
+        print(f"  +{report['edges_added']} / -{report['edges_removed']} edges, "
+              f"{report['dirty_shells']} dirty shells, {report['reused_shells']} reused")
+        print(f"  ✓ PASS" if np.array_equal(new_state['coreness'], expected) else f"  ✗ FAIL")
+
+        # Ties may be broken differently from a fresh peel, so the order is
+        # checked for validity rather than compared step by step
+        print(f"\nTest 10.2 ({name}): warm-started order is a minimum-degree peel of the new snapshot")
+        m = len(new_csr['neighbors']) // 2
+        ok = _is_min_degree_peel(new_csr['offsets'], new_csr['neighbors'],
+                                 new_state['order'], new_state['degree_at_removal'])
+        ok &= report['d0_new'] == int(state_profile(new_state, m)[2][0])
+        print(f"  d0: {report['d0_old']} → {report['d0_new']} {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 10.3: Snapshot edge files with raw ids above 2^31 parse without corruption")
+    import os
+    import tempfile
+    from graph_csr import edge_file_to_csr
+    raw = rng.choice(np.int64(1) << 62, size=G_old.number_of_nodes(), replace=False)
+    raw[:3] = [9, 1 << 31, 1 << 40]
+    nodes = list(G_old.nodes())
+    G_raw = nx.relabel_nodes(G_old, {v: int(raw[i]) for i, v in enumerate(nodes)})
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, 'edges.txt')
+        with open(path, 'w') as f:
+            # Every edge in both directions, plus a self-loop
+            for u, v in G_raw.edges():
+                f.write(f"{u} {v}\n{v} {u}\n")
+            f.write(f"{1 << 40} {1 << 40}\n")
+        offsets, neighbors, raw_ids = edge_file_to_csr(path, chunk_lines=997)
+    ok = np.array_equal(raw_ids, np.sort(raw))
+    src = np.repeat(raw_ids, np.diff(offsets))
+    parsed = {(int(u), int(v)) for u, v in zip(src, raw_ids[neighbors])}
+    ok &= parsed == {(u, v) for u, v in G_raw.edges()} | {(v, u) for u, v in G_raw.edges()}
+    ok &= len(neighbors) == 2 * G_raw.number_of_edges()
+    print(f"  n={len(raw_ids)}, m={len(neighbors) // 2} {'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def test_subset_views():
+    """Test masked and compacted induced-subgraph views against built subgraphs."""
+    print("\n" + "="*70)
+    print("TEST 11: Induced-Subgraph Views")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+    from approximate_peel import approximate_peel_states
+    from graph_csr import networkx_to_csr, view_mask, induced_csr
+
+    G = nx.barabasi_albert_graph(2000, 5, seed=11)
+    lsa = LargeSetArboricityIgraph.from_networkx(G, engine='numba')
+    offsets, neighbors = lsa.to_csr()
+    rng = np.random.default_rng(11)
+
+    for size in (100, 1500):
+        subset = np.sort(rng.choice(2000, size, replace=False))
+        H = nx.convert_node_labels_to_integers(G.subgraph(subset.tolist()), ordering='sorted')
+        reference = LargeSetArboricityIgraph.from_networkx(H, engine='numba')
+        expected = reference.compute_all_dk_optimized(verbose=False)[1]
+
+        print(f"\nTest 11.1 (|S|={size}): masked view and compacted CSR give the subgraph's dk profile")
+        masked = lsa.compute_all_dk_subset(subset, compact=False, verbose=False)[1]
+        compacted = lsa.compute_all_dk_subset(subset, compact=True, verbose=False)[1]
+        ok = np.array_equal(masked, expected) and np.array_equal(compacted, expected)
+        print(f"  |E(S)|={H.number_of_edges()}, d0={int(expected[0])} {'✓ PASS' if ok else '✗ FAIL'}")
+
+        print(f"\nTest 11.2 (|S|={size}): approximate rounds on the mask equal rounds on the subgraph")
+        V, E, layer = approximate_peel_states(offsets, neighbors, 0.1, mask=view_mask(2000, subset))
+        sub_offsets, sub_neighbors = induced_csr(offsets, neighbors, subset)
+        V_h, E_h, layer_h = approximate_peel_states(sub_offsets, sub_neighbors, 0.1)
+        ok = (np.array_equal(V, V_h) and np.array_equal(E, E_h)
+              and np.array_equal(layer[subset], layer_h)
+              and (np.delete(layer, subset) == -1).all())
+        print(f"  {len(V) - 1} rounds {'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def test_ego_networks():
+    """Test per-vertex ego-network profiles against nx.ego_graph."""
+    print("\n" + "="*70)
+    print("TEST 12: Ego-Network Profiles")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+
+    G = nx.barabasi_albert_graph(600, 3, seed=12)
+    lsa = LargeSetArboricityIgraph.from_networkx(G, engine='numba')
+    centres = np.arange(0, 600, 7)
+
+    for radius in (1, 2):
+        print(f"\nTest 12.1 (radius {radius}): d0 and degeneracy of every ego network")
+        dk0, degeneracy = lsa.compute_ego_profiles(radius, vertices=centres, num_threads=2, verbose=False)
+        ok = (np.delete(dk0, centres) == -1).all()
+        for v in centres:
+            ego = nx.convert_node_labels_to_integers(nx.ego_graph(G, int(v), radius), ordering='sorted')
+            expected = LargeSetArboricityIgraph.from_networkx(ego, engine='numba').compute_dk(0)
+            ok &= dk0[v] == expected and degeneracy[v] == max(nx.core_number(ego).values())
+        print(f"  {len(centres)} centres, max d0 {int(dk0.max())} {'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def _brute_alpha(G):
+    """αk = max over |S| > k of ⌈2e(S)/|S|⌉ for every k, by enumeration (small graphs only)."""
+    from itertools import combinations
+    nodes = list(G.nodes())
+    n = len(nodes)
+    best_at_size = [0] * (n + 1)
+    for size in range(1, n + 1):
+        for S in combinations(nodes, size):
+            e = G.subgraph(S).number_of_edges()
+            best_at_size[size] = max(best_at_size[size], -(-2 * e // size))
+    return [max(best_at_size[k + 1:]) for k in range(n)]
+
+
+def test_batched_graphs():
+    """Test the batched engine against per-graph peels and brute-force αk."""
+    print("\n" + "="*70)
+    print("TEST 13: Batched Small Graphs")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+    from batched_graphs import pack_graphs, batch_peel, batch_exact_alpha
+
+    graphs = [nx.gnm_random_graph(n, m, seed=s)
+              for s, (n, m) in enumerate([(9, 12), (10, 25), (8, 20), (1, 0), (7, 6), (10, 40)])]
+    graphs.append(nx.petersen_graph())
+    batch = pack_graphs(graphs)
+    ptr = batch['graph_ptr']
+
+    print("\nTest 13.1: Batched peel equals a peel of every graph on its own")
+    result = batch_peel(batch, verbose=False)
+    ok = True
+    for b, G in enumerate(graphs):
+        lsa = LargeSetArboricityIgraph.from_networkx(G, engine='numba')
+        ok &= np.array_equal(result['dk'][ptr[b]:ptr[b + 1]], lsa.compute_all_dk_optimized(verbose=False)[1])
+        core = nx.core_number(G)
+        ok &= all(result['coreness'][ptr[b] + v] == core[v] for v in G)
+        ok &= result['degeneracy'][b] == max(core.values())
+    print(f"  {len(graphs)} graphs {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 13.2: Batched exact αk equals brute force")
+    result = batch_exact_alpha(batch, verbose=False)
+    ok = bool(result['exact'].all())
+    for b, G in enumerate(graphs):
+        ok &= result['alpha'][ptr[b]:ptr[b + 1]].tolist() == _brute_alpha(G)
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+
+def test_exact_alpha_widths():
+    """Test the 64- to 512-bit exact αk solver and the shared exact dispatch."""
+    print("\n" + "="*70)
+    print("TEST 14: Exact αk Solver Widths and Dispatch")
+    print("="*70)
+
+    from graph_csr import networkx_to_csr
+    from exact_alpha import exact_alpha_profile, bitset_words
+    from treewidth_dp import exact_alpha_treewidth, exact_alpha_networkx_auto
+    from large_set_arboricity_snap import LargeSetArboricityOptimized
+
+    print("\nTest 14.1: Bitset solver equals the tree-decomposition DP at every width")
+    for rungs in (20, 35, 70, 150):
+        G = nx.ladder_graph(rungs)
+        G.add_edges_from(nx.complete_graph(6).edges())
+        offsets, neighbors, _ = networkx_to_csr(G)
+        alpha, exact = exact_alpha_profile(offsets, neighbors)
+        ok = exact and np.array_equal(alpha, exact_alpha_treewidth(offsets, neighbors)['alpha'])
+        print(f"  n={len(G)} ({64 * bitset_words(len(G))}-bit sets): α0={int(alpha[0])} "
+              f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 14.2: Exhausted search budget falls back to the DP")
+    G = nx.convert_node_labels_to_integers(nx.grid_2d_graph(6, 12))
+    G.add_edges_from(nx.complete_graph(6).edges())
+    alpha, witnesses, method = exact_alpha_networkx_auto(G, node_limit=1000)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    ok = method == 'treewidth' and witnesses is None
+    ok &= np.array_equal(alpha, exact_alpha_treewidth(offsets, neighbors)['alpha'])
+    print(f"  method={method} {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 14.3: Wrappers share the dispatch and reject negative k")
+    G = nx.petersen_graph()
+    expected = _brute_alpha(G)
+    ok = True
+    for cls in (LargeSetArboricity, LargeSetArboricityOptimized):
+        lsa = cls(G)
+        for k in (0, 3, 7):
+            value, H = lsa.compute_alpha_k_exact(k)
+            ok &= value == expected[k] and H.number_of_nodes() > k
+            ok &= -(-2 * H.number_of_edges() // H.number_of_nodes()) == value
+        try:
+            lsa.compute_alpha_k_exact(-1)
+            ok = False
+        except ValueError:
+            pass
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+
+def test_treewidth_dp():
+    """Test the tree-decomposition DP against brute force."""
+    print("\n" + "="*70)
+    print("TEST 15: Tree-Decomposition DP")
+    print("="*70)
+
+    from itertools import combinations
+    from graph_csr import networkx_to_csr
+    from treewidth_dp import exact_alpha_treewidth
+
+    print("\nTest 15.1: f(s) and αk equal brute force for both elimination heuristics")
+    cases = [("Grid 3x4", nx.convert_node_labels_to_integers(nx.grid_2d_graph(3, 4))),
+             ("Wheel W10", nx.wheel_graph(10)),
+             ("G(11, 22)", nx.gnm_random_graph(11, 22, seed=15)),
+             ("Tree + K4", nx.compose(nx.random_labeled_tree(11, seed=15), nx.complete_graph(4)))]
+    for name, G in cases:
+        offsets, neighbors, _ = networkx_to_csr(G)
+        n = len(G)
+        f = [max(G.subgraph(S).number_of_edges() for S in combinations(G.nodes(), s))
+             for s in range(n + 1)]
+        ok = True
+        for heuristic in ('min_degree', 'min_fill'):
+            result = exact_alpha_treewidth(offsets, neighbors, heuristic, max_width=n)
+            ok &= result['f'].tolist() == f and result['alpha'].tolist() == _brute_alpha(G)
+        print(f"  {name}: width {result['width']} {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 15.2: The solver declines above max_width")
+    G = nx.complete_graph(12)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    print(f"  ✓ PASS" if exact_alpha_treewidth(offsets, neighbors, max_width=5) is None else f"  ✗ FAIL")
+
+
+def test_degree_bounds():
+    """Test that degree-sequence bounds bracket dk, αk and the degeneracy."""
+    print("\n" + "="*70)
+    print("TEST 16: Degree-Sequence Bounds")
+    print("="*70)
+
+    import os
+    import tempfile
+    from large_set_arboricity import LargeSetArboricityIgraph
+    from graph_csr import networkx_to_csr, save_arrays
+    from degree_bounds import degree_sequence_bounds, fast_bounds
+
+    print("\nTest 16.1: dk_lower ≤ dk ≤ αk ≤ dk_upper for every k, degeneracy bracketed")
+    for name, G in [("BA(1000, 4)", nx.barabasi_albert_graph(1000, 4, seed=16)),
+                    ("G(600, 3000)", nx.gnm_random_graph(600, 3000, seed=16)),
+                    ("Star + K8", nx.compose(nx.star_graph(50), nx.complete_graph(8)))]:
+        lsa = LargeSetArboricityIgraph.from_networkx(G, engine='numba')
+        dk = lsa.compute_all_dk_optimized(verbose=False)[1]
+        bounds = degree_sequence_bounds([d for _, d in G.degree()])
+        degeneracy = max(nx.core_number(G).values())
+        ok = bool((bounds['dk_lower'] <= dk).all() and (dk <= bounds['dk_upper']).all())
+        ok &= bounds['degeneracy_lower'] <= degeneracy <= bounds['degeneracy_upper']
+        print(f"  {name}: d0 ∈ [{bounds['d0_lower']}, {bounds['d0_upper']}] ∋ {int(dk[0])}, "
+              f"degeneracy ∈ [{bounds['degeneracy_lower']}, {bounds['degeneracy_upper']}] ∋ {degeneracy} "
+              f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+    G = nx.petersen_graph()
+    bounds = degree_sequence_bounds([d for _, d in G.degree()])
+    print(f"  Petersen: αk ≤ dk_upper for every k "
+          f"{'✓ PASS' if all(a <= u for a, u in zip(_brute_alpha(G), bounds['dk_upper'])) else '✗ FAIL'}")
+
+    print("\nTest 16.2: fast_bounds from a CSR cache and from a two-way edge list")
+    G = nx.barabasi_albert_graph(1000, 4, seed=16)
+    dk = LargeSetArboricityIgraph.from_networkx(G, engine='numba').compute_all_dk_optimized(verbose=False)[1]
+    with tempfile.TemporaryDirectory() as tmp:
+        offsets, neighbors, _ = networkx_to_csr(G)
+        csr_path = os.path.join(tmp, 'graph.bin')
+        save_arrays(csr_path, {'offsets': offsets, 'neighbors': neighbors})
+        edge_path = os.path.join(tmp, 'edges.txt')
+        with open(edge_path, 'w') as f:
+            for u, v in G.edges():
+                f.write(f"{u} {v}\n{v} {u}\n")
+        from_csr = fast_bounds(csr_path, verbose=False)
+        from_edges = fast_bounds(edge_path, multiplicity=2, verbose=False)
+    ok = from_csr['source'] == 'csr' and from_csr['m'] == G.number_of_edges()
+    ok &= from_edges['source'] == 'edge_list' and from_edges['m_lower'] == G.number_of_edges()
+    for b in (from_csr, from_edges):
+        ok &= bool((b['dk_lower'] <= dk).all() and (dk <= b['dk_upper']).all())
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+
+def test_anytime_bounds():
+    """Test that anytime intervals bracket dk and αk, only tighten and converge."""
+    print("\n" + "="*70)
+    print("TEST 17: Anytime Bounds")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+    from graph_csr import networkx_to_csr
+    from anytime_bounds import AnytimeBounds
+
+    print("\nTest 17.1: Every snapshot brackets dk and brute-force αk, intervals only tighten")
+    G = nx.gnm_random_graph(13, 22, seed=3)
+    alpha = np.array(_brute_alpha(G))
+    lsa = LargeSetArboricityIgraph.from_networkx(G, engine='numba')
+    dk = lsa.compute_all_dk_optimized(verbose=False)[1]
+    snapshots = []
+    final = lsa.compute_bounds_anytime(tolerance=0, callback=snapshots.append, verbose=False)
+    ok = len(snapshots) > 1
+    for s in snapshots:
+        ok &= bool((s['dk_lower'] <= dk).all() and (dk <= s['dk_upper']).all())
+        ok &= bool((s['alpha_lower'] <= alpha).all() and (alpha <= s['alpha_upper']).all())
+    for prev, cur in zip(snapshots, snapshots[1:]):
+        for key in ('dk_lower', 'alpha_lower'):
+            ok &= bool((cur[key] >= prev[key]).all())
+        for key in ('dk_upper', 'alpha_upper'):
+            ok &= bool((cur[key] <= prev[key]).all())
+    print(f"  stages: {[s['stage'] for s in snapshots]}")
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 17.2: tolerance=0 ends converged on the exact αk, with and without Greedy++")
+    ok = True
+    for final in (final, lsa.compute_bounds_anytime(tolerance=0, verbose=False, greedy_iterations=0)):
+        ok &= final['converged'] and np.array_equal(final['alpha_lower'], alpha)
+        ok &= np.array_equal(final['alpha_upper'], alpha)
+        print(f"  final stage: {final['stage']}")
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 17.3: target='dk' stops at the peel; start/wait matches run")
+    G = nx.barabasi_albert_graph(500, 3, seed=17)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    dk = LargeSetArboricityIgraph.from_networkx(G, engine='numba').compute_all_dk_optimized(verbose=False)[1]
+    result = AnytimeBounds(offsets, neighbors, target='dk').run()
+    ok = result['stage'] == 'peel' and result['converged']
+    ok &= np.array_equal(result['dk_lower'], dk) and np.array_equal(result['dk_upper'], dk)
+    driver = AnytimeBounds(offsets, neighbors, target='dk')
+    driver.start()
+    background = driver.wait(timeout=60)
+    ok &= background is not None and background['stage'] == 'peel'
+    ok &= np.array_equal(background['dk_lower'], dk)
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+
+def test_witness_api():
+    """Test the shared-peel witness and batch bound-verification API."""
+    print("\n" + "="*70)
+    print("TEST 18: Witness and Bound-Verification API")
+    print("="*70)
+
+    import math
+
+    print("\nTest 18.1: Removal sequence is a min-degree peel, witnesses certify dk for every k")
+    G = nx.relabel_nodes(nx.gnm_random_graph(40, 120, seed=18), lambda v: f"v{v}")
+    lsa = LargeSetArboricity(G)
+    dk_all = lsa.compute_all_dk()
+    _, removal_seq = lsa.modified_degeneracy_algorithm(0)
+    H = G.copy()
+    ok = len(removal_seq) == G.number_of_nodes()
+    for v, d in removal_seq:
+        ok &= H.degree(v) == d == min(d for _, d in H.degree())
+        H.remove_node(v)
+    for k in range(G.number_of_nodes()):
+        dk_G, seq = lsa.modified_degeneracy_algorithm(k)
+        witness = lsa.construct_witness_subgraph(k)
+        ok &= dk_G == dk_all[k] == max(d for _, d in seq) and len(seq) == G.number_of_nodes() - k
+        ok &= witness.number_of_nodes() > k and min(d for _, d in witness.degree()) >= dk_G
+        ok &= sorted(witness.nodes()) == sorted(lsa.witness_vertices(k))
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 18.2: Exact batch verification matches brute-force αk")
+    G = nx.gnm_random_graph(12, 26, seed=18)
+    lsa = LargeSetArboricity(G)
+    batch = lsa.verify_approximation_bounds()
+    alpha = _brute_alpha(G)
+    ok = batch['exact'] and batch['alpha_k'].tolist() == alpha
+    ok &= bool(batch['lower_bound_holds'].all())
+    ok &= np.array_equal(batch['upper_bound_holds'], batch['alpha_k'] <= 2 * batch['dk'])
+    for k in (0, 5, 11):
+        single = lsa.verify_approximation_bound(k)
+        value, best = lsa.compute_alpha_k_exact(k)
+        ok &= single['alpha_k'] == value == alpha[k] and best.number_of_nodes() > k
+        ok &= math.ceil(LargeSetArboricity.average_degree(best)) == value
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 18.3: Without an exact solver the orientation bound still covers every witness")
+    G = nx.gnm_random_graph(600, 4000, seed=18)
+    lsa = LargeSetArboricity(G)
+    ks = np.array([0, 10, 100, 300, 599])
+    batch = lsa.verify_approximation_bounds(ks)
+    ok = not batch['exact'] and bool(np.isnan(batch['ratio']).all())
+    for i, k in enumerate(ks):
+        witness = lsa.construct_witness_subgraph(int(k))
+        ok &= batch['dk'][i] <= math.ceil(lsa.average_degree(witness)) <= batch['alpha_k_upper'][i]
+    ok &= lsa.verify_approximation_bound(0)['alpha_k'] == 'N/A'
+    print(f"  upper bound certified for {int(batch['upper_bound_holds'].sum())}/{len(ks)} k "
+          f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def test_triangles():
+    """Test oriented triangle counting and clustering against networkx."""
+    print("\n" + "="*70)
+    print("TEST 19: Triangle Counting and Clustering")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+    from graph_csr import networkx_to_csr
+    from triangles import triangle_counts, clustering_networkx
+
+    isolated = nx.Graph([(0, 1)])
+    isolated.add_nodes_from(range(2, 5))
+    graphs = [("K6", nx.complete_graph(6)),
+              ("BA(2000, 5)", nx.barabasi_albert_graph(2000, 5, seed=19)),
+              ("Clustered(1500)", nx.powerlaw_cluster_graph(1500, 4, 0.6, seed=19)),
+              ("Triangle-free C20", nx.cycle_graph(20)),
+              ("Isolated + edge", isolated)]
+
+    print("\nTest 19.1: Per-vertex counts match nx.triangles")
+    for name, G in graphs:
+        offsets, neighbors, nodes = networkx_to_csr(G)
+        expected = nx.triangles(G)
+        t = triangle_counts(offsets, neighbors)
+        ok = t.tolist() == [expected[v] for v in nodes]
+        print(f"  {name}: {int(t.sum()) // 3} triangles {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 19.2: Local/average clustering and transitivity match networkx")
+    for name, G in graphs:
+        result = clustering_networkx(G)
+        local = nx.clustering(G)
+        ok = np.allclose(result['local_clustering'], [local[v] for v in result['nodes']])
+        ok &= abs(result['average_clustering'] - nx.average_clustering(G)) < 1e-9
+        ok &= abs(result['transitivity'] - nx.transitivity(G)) < 1e-9
+        ok &= result['total_triangles'] == sum(nx.triangles(G).values()) // 3
+        print(f"  {name}: {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 19.3: compute_clustering on every engine")
+    G = graphs[2][1]
+    expected = nx.triangles(G)
+    ok = True
+    for engine in LargeSetArboricityIgraph.ENGINES:
+        result = LargeSetArboricityIgraph.from_networkx(G, engine=engine).compute_clustering()
+        ok &= result['triangles'].tolist() == [expected[v] for v in range(G.number_of_nodes())]
+        ok &= abs(result['transitivity'] - nx.transitivity(G)) < 1e-9
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+
+def test_graph_stats():
+    """Test the single-sweep statistics report against networkx."""
+    print("\n" + "="*70)
+    print("TEST 20: Graph Statistics Report")
+    print("="*70)
+
+    import tempfile
+    import graph_stats
+    from graph_csr import networkx_to_csr
+
+    print("\nTest 20.1: Counts, degrees and components match networkx")
+    forest = nx.disjoint_union_all([nx.gnm_random_graph(300, 900, seed=20),
+                                    nx.path_graph(40), nx.complete_graph(7), nx.empty_graph(5)])
+    for name, G in [("BA(3000, 3)", nx.barabasi_albert_graph(3000, 3, seed=20)),
+                    ("Disjoint union", forest)]:
+        report = graph_stats.graph_stats_networkx(G)
+        components = sorted(len(c) for c in nx.connected_components(G))
+        largest = max(nx.connected_components(G), key=len)
+        ok = report['n'] == G.number_of_nodes() and report['m'] == G.number_of_edges()
+        ok &= abs(report['density'] - nx.density(G)) < 1e-12
+        ok &= report['degree_histogram'].tolist() == nx.degree_histogram(G)
+        ok &= report['connected'] == nx.is_connected(G)
+        ok &= report['components'] == len(components)
+        ok &= report['component_size_histogram'].tolist() == np.bincount(components).tolist()
+        ok &= report['largest_component'] == len(largest)
+        ok &= report['largest_component_edges'] == G.subgraph(largest).number_of_edges()
+        ok &= report['isolated'] == nx.number_of_isolates(G)
+        ok &= report['self_loops'] == 0 and report['multi_edges'] == 0
+        print(f"  {name}: {report['components']} components {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 20.2: Self-loops and parallel edges of a multigraph")
+    G = nx.MultiGraph(nx.cycle_graph(10))
+    G.add_edges_from([(0, 1), (0, 1), (2, 3), (4, 4), (5, 5), (5, 5)])
+    report = graph_stats.graph_stats_networkx(G)
+    ok = report['self_loops'] == nx.number_of_selfloops(G) == 3
+    ok &= report['multi_edges'] == 4  # two extra 0-1, one extra 2-3, one extra 5-5
+    ok &= report['degree_histogram'].tolist() == nx.degree_histogram(G)
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 20.3: Reports are cached by fingerprint, in memory and on disk")
+    G = nx.gnm_random_graph(500, 2000, seed=20)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    with tempfile.TemporaryDirectory() as tmp:
+        first = graph_stats.graph_stats(offsets, neighbors, cache_dir=tmp)
+        graph_stats._REPORTS.clear()
+        stored = graph_stats.graph_stats(offsets, neighbors, cache_dir=tmp)
+    ok = stored['time'] == 0.0 and stored['fingerprint'] == first['fingerprint']
+    for key, value in first.items():
+        if key != 'time':
+            ok &= np.array_equal(value, stored[key]) if isinstance(value, np.ndarray) \
+                else value == stored[key]
+    shifted = neighbors.copy()
+    shifted[[0, 1]] = shifted[[1, 0]]
+    ok &= graph_stats.csr_fingerprint(offsets, shifted) != first['fingerprint']
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+
+def test_dataset_catalog():
+    """Test catalog ingest, estimates and wave planning."""
+    print("\n" + "="*70)
+    print("TEST 21: Dataset Catalog and Batch Planning")
+    print("="*70)
+
+    import gzip
+    import os
+    import tempfile
+    from snap_api import SNAPLoader
+    from dataset_catalog import DatasetCatalog, plan_batches
+
+    print("\nTest 21.1: ingest() records exact counts, degeneracy and a persistent entry")
+    G = nx.barabasi_albert_graph(800, 4, seed=21)
+    G.add_edges_from([(900, 901), (901, 902), (5, 5)])
+    with tempfile.TemporaryDirectory() as tmp:
+        loader = SNAPLoader(cache_dir=tmp)
+        with gzip.open(loader.edge_cache_file('ca-GrQc'), 'wt') as f:
+            f.write("# synthetic edge list\n")
+            for u, v in G.edges():
+                f.write(f"{u}\t{v}\n{v}\t{u}\n")
+        entry = loader.ingest('ca-GrQc', verbose=False)
+        reopened = DatasetCatalog(os.path.join(tmp, 'catalog.json'))
+    simple = nx.Graph(G)
+    simple.remove_edges_from(list(nx.selfloop_edges(simple)))
+    largest = max(nx.connected_components(simple), key=len)
+    ok = entry['n'] == simple.number_of_nodes() and entry['m'] == simple.number_of_edges()
+    ok &= entry['largest_component'] == len(largest)
+    ok &= entry['max_degree'] == max(d for _, d in simple.degree())
+    ok &= entry['degeneracy'] == max(nx.core_number(simple).values())
+    ok &= 'csr_build_seconds' in entry and reopened.get('ca-GrQc') == entry
+    estimate = reopened.estimate('ca-GrQc')
+    ok &= estimate['memory_bytes'] > entry['csr_bytes'] and estimate['seconds'] >= entry['peel_seconds']
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 21.2: plan_batches respects the budget and worker count, longest first")
+    with tempfile.TemporaryDirectory() as tmp:
+        catalog = DatasetCatalog(os.path.join(tmp, 'catalog.json'))
+        rng = np.random.default_rng(21)
+        for i in range(12):
+            catalog.record(f"g{i}", n=int(rng.integers(1, 1000)), m=0, max_degree=10,
+                           csr_bytes=int(rng.integers(1, 400)) * 1000, load_seconds=0.0,
+                           peel_seconds=float(rng.random()))
+        catalog.record("huge", n=1, m=0, max_degree=1, csr_bytes=10**9,
+                       load_seconds=0.0, peel_seconds=0.5)
+        catalog.record("partial", csr_build_seconds=1.0)
+        names = [f"g{i}" for i in range(12)] + ["huge", "partial", "unknown"]
+        budget = 600_000
+        waves = plan_batches(catalog, names, budget, workers=3)
+        estimates = {name: catalog.estimate(name) for name in names}
+    ok = sorted(sum(waves, [])) == sorted(names)
+    ok &= waves[-2:] == [["partial"], ["unknown"]] and ["huge"] in waves
+    for wave in waves[:-2]:
+        ok &= len(wave) <= 3
+        if wave != ["huge"]:
+            ok &= sum(estimates[name]['memory_bytes'] for name in wave) <= budget
+    firsts = [estimates[wave[0]]['seconds'] for wave in waves[:-2]]
+    ok &= firsts == sorted(firsts, reverse=True)
+    print(f"  {len(waves)} waves {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 21.3: networkx runs are planned from their measured peak, not the CSR size")
+    with tempfile.TemporaryDirectory() as tmp:
+        catalog = DatasetCatalog(os.path.join(tmp, 'catalog.json'))
+        for name in ("a", "b", "c"):
+            catalog.record(name, n=1000, m=5000, max_degree=10, csr_bytes=100_000,
+                           load_seconds=0.0, peel_seconds=0.1)
+        catalog.record("a", analysis_peak_bytes=700_000, analysis_seconds=3.0)
+        catalog.record("b", analysis_peak_bytes=200_000, analysis_seconds=2.0)
+        catalog.record("d", analysis_peak_bytes=100_000, analysis_seconds=1.0)
+        csr_waves = plan_batches(catalog, "abcd", 1_000_000, workers=4)
+        nx_waves = plan_batches(catalog, "abcd", 1_000_000, workers=4, run='networkx')
+        ok = csr_waves == [["a", "b", "c"], ["d"]]
+        ok &= nx_waves == [["a", "b", "d"], ["c"]]
+        ok &= catalog.estimate("c", run='networkx') is None
+        try:
+            catalog.estimate("a", run='igraph')
+            ok = False
+        except ValueError:
+            pass
+    print(f"  {nx_waves} {'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def test_residency():
+    """Test LRU eviction, reload, spill and pinning of the residency manager."""
+    print("\n" + "="*70)
+    print("TEST 22: Residency Manager")
+    print("="*70)
+
+    import os
+    import tempfile
+    from graph_csr import networkx_to_csr, save_arrays, load_arrays
+    from residency import ResidencyManager
+
+    block = 8000  # bytes of one int64[1000]
+    with tempfile.TemporaryDirectory() as tmp:
+        print("\nTest 22.1: Least recently used loadable entries are evicted and reloaded")
+        calls = {}
+
+        def loader(i):
+            def load():
+                calls[i] = calls.get(i, 0) + 1
+                return np.arange(1000, dtype=np.int64) * (i + 1)
+            return load
+
+        manager = ResidencyManager(3 * block)
+        for i in range(4):
+            manager.register(('g', i), loader(i))
+        for i in (0, 1, 2):
+            manager.get(('g', i))
+        manager.get(('g', 0))  # 1 is now least recently used
+        manager.get(('g', 3))
+        ok = not manager.is_resident(('g', 1)) and all(manager.is_resident(('g', i)) for i in (0, 2, 3))
+        ok &= manager.resident_bytes <= manager.budget_bytes
+        ok &= np.array_equal(manager.get(('g', 1)), np.arange(1000) * 2) and calls[1] == 2
+        stats = manager.stats()
+        ok &= stats['loads'] == 4 and stats['reloads'] == 1 and stats['hits'] == 1
+        ok &= stats['evictions'] == 2 and stats['resident'] == 3
+        print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+        print("\nTest 22.2: Memory-mapped CSRs are dropped, not copied, and map back unchanged")
+        offsets, neighbors, _ = networkx_to_csr(nx.gnm_random_graph(500, 3000, seed=22))
+        path = os.path.join(tmp, 'graph.csr.bin')
+        save_arrays(path, {'offsets': offsets, 'neighbors': neighbors})
+        csr_bytes = offsets.nbytes + neighbors.nbytes
+        manager = ResidencyManager(csr_bytes + block, spill_dir=os.path.join(tmp, 'spill'))
+        manager.register('csr', lambda: load_arrays(path, mmap=True), expected_bytes=csr_bytes)
+        ok = manager.stats()['resident'] == 0 and manager.get('csr') is not None
+        ok &= manager.stats()['mapped_bytes'] == csr_bytes
+        manager.put('big', np.zeros(2000, dtype=np.int64))
+        ok &= not manager.is_resident('csr') and manager.stats()['spills'] == 0
+        csr = manager.get('csr')
+        ok &= np.array_equal(csr['offsets'], offsets) and np.array_equal(csr['neighbors'], neighbors)
+        print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+        print("\nTest 22.3: Computed results spill to disk and come back; others stay pinned")
+        manager = ResidencyManager(2 * block, spill_dir=os.path.join(tmp, 'spill'))
+        core = {'order': np.arange(1000, dtype=np.int64)[::-1].copy(),
+                'coreness': np.full(1000, 7, dtype=np.int64)}
+        pinned = np.ones((10, 100), dtype=np.int64)  # 2-D: not spillable
+        manager.put('core', core)
+        manager.put('pinned', pinned)
+        manager.put('other', np.zeros(1000, dtype=np.int64))
+        back = manager.get('core')
+        ok = manager.stats()['spills'] >= 1 and manager.is_resident('pinned')
+        ok &= all(np.array_equal(back[key], core[key]) for key in core)
+        spilled = len(os.listdir(manager.spill_dir))
+        manager.remove('core')
+        ok &= 'core' not in manager and len(os.listdir(manager.spill_dir)) == spilled - 1
+        print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+        print("\nTest 22.4: An entry larger than the budget still loads")
+        manager = ResidencyManager(block // 2)
+        manager.register('large', lambda: np.arange(1000, dtype=np.int64))
+        ok = len(manager.get('large')) == 1000 and manager.is_resident('large')
+        manager.register('next', lambda: np.arange(1000, dtype=np.int64))
+        manager.get('next')
+        ok &= not manager.is_resident('large') and manager.is_resident('next')
+        print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+
+def test_versioned_graph():
+    """Test versioned coreness under batches against networkx, and version isolation."""
+    print("\n" + "="*70)
+    print("TEST 23: Copy-on-Write Versioned Graph")
+    print("="*70)
+
+    from graph_csr import networkx_to_csr
+    from versioned_graph import VersionedGraph
+
+    print("\nTest 23.1: Incrementally maintained core numbers match nx.core_number after every batch")
+    rng = np.random.default_rng(23)
+    G = nx.barabasi_albert_graph(600, 3, seed=23)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    graph = VersionedGraph(offsets, neighbors, block_size=64, budget_factor=100.0)
+    ok = True
+    for batch in range(30):
+        edges = list(G.edges())
+        delete = [edges[i] for i in rng.choice(len(edges), size=20, replace=False)]
+        insert = [tuple(e) for e in rng.integers(0, 600, size=(25, 2))]
+        if batch % 10 == 9:
+            insert += [(0, v) for v in range(1, 200)]  # outgrows the slack of vertex 0
+        version = graph.apply(insert, delete)
+        G.remove_edges_from(delete)
+        G.add_edges_from((u, v) for u, v in insert if u != v)
+        core = nx.core_number(G)
+        ok &= version.coreness().tolist() == [core[v] for v in range(600)]
+        ok &= version.m == G.number_of_edges()
+        ok &= all(sorted(version.neighbors(v).tolist()) == sorted(G[v]) for v in (0, 1, 599))
+    stats = graph.stats()
+    ok &= stats['slack_rebuilds'] > 0 and stats['core_recomputes'] == 0 and stats['epoch'] == 30
+    print(f"  {stats['inserted']} inserted, {stats['deleted']} deleted, "
+          f"{stats['slack_rebuilds']} slack rebuilds, {stats['core_recomputes']} full recomputes "
+          f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 23.2: Full-peel fallback (zero traversal budget) gives the same core numbers")
+    G = nx.gnm_random_graph(300, 1200, seed=23)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    graph = VersionedGraph(offsets, neighbors, block_size=32, budget_factor=0.0)
+    edges = list(G.edges())[:40]
+    version = graph.apply(insert=[(1, 2), (3, 4), (5, 6)], delete=edges)
+    G.remove_edges_from(edges)
+    G.add_edges_from([(1, 2), (3, 4), (5, 6)])
+    core = nx.core_number(G)
+    ok = version.coreness().tolist() == [core[v] for v in range(300)]
+    ok &= graph.stats()['core_recomputes'] == 1
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 23.3: Pinned versions stay intact; untouched blocks are shared")
+    G = nx.barabasi_albert_graph(1000, 2, seed=23)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    graph = VersionedGraph(offsets, neighbors, block_size=100)
+    with graph.snapshot() as old:
+        before = old.to_csr()[1].copy(), old.coreness()
+        graph.apply(insert=[(990, 995), (991, 996)])
+        graph.apply(delete=[(990, 995)])
+        ok = np.array_equal(old.to_csr()[1], before[0]) and np.array_equal(old.coreness(), before[1])
+        ok &= not old.released and graph.stats()['retired'] == 2
+        shared = sum(a is b for a, b in zip(old.blocks, graph.current.blocks))
+        ok &= shared == len(old.blocks) - 1
+    graph.reclaim()
+    ok &= old.released and graph.stats()['retired'] == 0 and graph.stats()['pinned'] == 0
+    print(f"  {shared}/{len(graph.current.blocks)} adjacency blocks shared "
+          f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 23.4: Out-of-range endpoints are rejected")
+    try:
+        graph.apply(insert=[(0, 1000)])
+        print(f"  ✗ FAIL")
+    except ValueError:
+        print(f"  ✓ PASS")
+
+
+def test_update_log():
+    """Test write-ahead log recovery: torn tails, snapshots and pruning."""
+    print("\n" + "="*70)
+    print("TEST 24: Write-Ahead Update Log and Recovery")
+    print("="*70)
+
+    import os
+    import tempfile
+    from graph_csr import networkx_to_csr
+    from update_log import LoggedGraph, encode_record, _epoch_files
+
+    def edge_set(version):
+        offsets, neighbors = version.to_csr()
+        src = np.repeat(np.arange(version.n), np.diff(offsets))
+        return {(int(u), int(v)) for u, v in zip(src, neighbors) if u < v}
+
+    def random_batches(logged, rng, count):
+        for _ in range(count):
+            current = logged.current
+            delete = [(int(v), int(current.neighbors(v)[0])) for v in rng.integers(0, current.n, size=10)
+                      if current.degree(v) > 0]
+            logged.apply(rng.integers(0, current.n, size=(12, 2)), delete)
+
+    G = nx.barabasi_albert_graph(500, 3, seed=24)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    rng = np.random.default_rng(24)
+    with tempfile.TemporaryDirectory() as tmp:
+        print("\nTest 24.1: Recovery after a crash with a torn record restores epoch and coreness")
+        logged = LoggedGraph.open(tmp, offsets, neighbors, sync=False)
+        random_batches(logged, rng, 15)
+        logged.apply(insert=[(1, 2)])
+        logged.apply(delete=[(1, 2)])
+        logged.apply(insert=[(1, 2)])  # net effect across the tail: inserted
+        epoch, core, edges = logged.current.epoch, logged.current.coreness(), edge_set(logged.current)
+        segment = _epoch_files(tmp, 'wal', '.log')[-1][1]
+        size = os.path.getsize(segment)
+        with open(segment, 'ab') as f:
+            f.write(encode_record(epoch + 1, np.zeros((0, 2)), np.ones((10, 2)))[:-7])
+        del logged
+
+        recovered = LoggedGraph.open(tmp)
+        H = nx.Graph(list(edges))
+        H.add_nodes_from(range(500))
+        expected = nx.core_number(H)
+        ok = recovered.current.epoch == epoch and recovered.stats()['replayed'] == 18
+        ok &= np.array_equal(recovered.current.coreness(), core) and edge_set(recovered.current) == edges
+        ok &= core.tolist() == [expected[v] for v in range(500)]
+        ok &= os.path.getsize(segment) == size and (1, 2) in edges
+        print(f"  epoch {recovered.current.epoch}, {recovered.stats()['replayed']} records replayed "
+              f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+        print("\nTest 24.2: Batches after recovery are logged and recovered again")
+        recovered.apply(insert=[(3, 499)])
+        random_batches(recovered, rng, 3)
+        epoch, core, edges = recovered.current.epoch, recovered.current.coreness(), edge_set(recovered.current)
+        recovered.close()
+        reopened = LoggedGraph.open(tmp)
+        ok = reopened.current.epoch == epoch and (3, 499) in edge_set(reopened.current)
+        ok &= np.array_equal(reopened.current.coreness(), core) and edge_set(reopened.current) == edges
+        reopened.close()
+        print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        print("\nTest 24.3: Periodic snapshots bound the replayed tail and prune old files")
+        logged = LoggedGraph.open(tmp, offsets, neighbors, sync=False, snapshot_every=5,
+                                  keep_snapshots=2)
+        random_batches(logged, rng, 23)
+        epoch, core, dk = logged.current.epoch, logged.current.coreness(), logged.current.dk_values()
+        logged.close()
+        recovered = LoggedGraph.open(tmp)
+        stats = recovered.stats()
+        ok = len(_epoch_files(tmp, 'snapshot', '.bin')) == 2
+        ok &= stats['snapshot_epoch'] == 20 and stats['replayed'] == 3
+        ok &= recovered.current.epoch == epoch and np.array_equal(recovered.current.coreness(), core)
+        ok &= np.array_equal(recovered.current.dk_values(), dk)
+        recovered.close()
+        print(f"  snapshot {stats['snapshot_epoch']} + {stats['replayed']} records "
+              f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def test_turnstile_sketch():
+    """Test the turnstile sketch: deletions, merging, persistence and estimates."""
+    print("\n" + "="*70)
+    print("TEST 25: Turnstile Densest-Subgraph Sketch")
+    print("="*70)
+
+    import os
+    import tempfile
+    from graph_csr import networkx_to_csr
+    from turnstile_sketch import TurnstileDensestSketch
+    from anytime_bounds import _greedy_pp_pass
+
+    def keyset(edges):
+        return {(min(int(u), int(v)), max(int(u), int(v))) for u, v in edges}
+
+    rng = np.random.default_rng(25)
+    G = nx.gnm_random_graph(400, 1500, seed=25)
+    edges = np.array(G.edges(), dtype=np.int64)
+    noise_keys = np.setdiff1d(np.unique(rng.integers(0, 400 * 400, size=3000)),
+                              edges.min(axis=1) * 400 + edges.max(axis=1))
+    noise = np.stack((noise_keys // 400, noise_keys % 400), axis=1)
+    noise = noise[noise[:, 0] < noise[:, 1]]
+
+    print("\nTest 25.1: Deleted edges vanish; a full-rate level decodes the exact edge set")
+    sketch = TurnstileDensestSketch(400)
+    sketch.insert(noise)
+    sketch.insert(edges)
+    sketch.delete(noise)
+    sample = sketch.sample()
+    ok = sketch.m == len(edges) and sample['rate'] == 1.0
+    ok &= keyset(sample['edges']) == keyset(edges) and len(sample['edges']) == len(edges)
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 25.2: Merging worker sketches equals sketching the whole stream")
+    parts = np.array_split(rng.permutation(len(edges)), 3)
+    workers = [TurnstileDensestSketch(400) for _ in range(3)]
+    for w, part in enumerate(parts):
+        workers[w].insert(noise[w::3])
+        workers[w].insert(edges[part])
+        workers[(w + 1) % 3].delete(noise[w::3])
+    merged = workers[2]
+    merged += workers[0]
+    merged += workers[1]
+    ok = all(np.array_equal(getattr(merged, name), getattr(sketch, name))
+             for name in ('counts', 'key_sums', 'check_sums'))
+    ok &= merged.m == sketch.m
+    try:
+        merged.merge(TurnstileDensestSketch(400, seed=1))
+        ok = False
+    except ValueError:
+        pass
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 25.3: save()/load() round trip")
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, 'sketch.bin')
+        size = sketch.save(path)
+        loaded = TurnstileDensestSketch.load(path)
+        ok = size == os.path.getsize(path) and loaded.m == sketch.m
+    ok &= all(np.array_equal(getattr(loaded, name), getattr(sketch, name))
+              for name in ('counts', 'key_sums', 'check_sums'))
+    ok &= keyset(loaded.sample()['edges']) == keyset(edges)
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 25.4: A subsampled level estimates the densest-subgraph density within ε")
+    G = nx.barabasi_albert_graph(3000, 20, seed=25)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    load = np.zeros(G.number_of_nodes(), dtype=np.int64)
+    exact = max(float(np.max(ge / gv))
+                for gv, ge in (_greedy_pp_pass(offsets, neighbors, load) for _ in range(8)))
+    sketch = TurnstileDensestSketch(3000, epsilon=0.5, cells_per_vertex=8)
+    sketch.insert(np.array(G.edges(), dtype=np.int64))
+    result = sketch.estimate()
+    ok = result['rate'] < 1.0 and abs(result['density'] / exact - 1) <= sketch.epsilon
+    ok &= result['m'] == G.number_of_edges() and len(result['dk']) == 3000
+    print(f"  p = {result['rate']:g}: density {result['density']:.2f} vs {exact:.2f} "
+          f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+
+def _replay_rank_errors(offsets, neighbors, result):
+    """Rank error of every pop recounted from the epoch-start degrees of the remaining graph."""
+    n = len(offsets) - 1
+    order = result['order']
+    seen = result['degree_at_removal']
+    alive = np.ones(n, dtype=bool)
+    expected = np.zeros(n, dtype=np.int64)
+    for start, end in zip(result['epoch_start'], result['epoch_start'][1:]):
+        remaining = np.flatnonzero(alive)
+        degrees = np.array([alive[neighbors[offsets[v]:offsets[v + 1]]].sum() for v in remaining])
+        lo = degrees.min()
+        ranks = np.searchsorted(np.sort(degrees), seen[start:end])
+        expected[start:end] = np.where(seen[start:end] > lo, ranks, 0)
+        alive[order[start:end]] = False
+    return expected
+
+
+def test_multiqueue_peel():
+    """Test the relaxed MultiQueue peel: exactness limit, rank errors and dk validity."""
+    print("\n" + "="*70)
+    print("TEST 26: MultiQueue Relaxed Peel")
+    print("="*70)
+
+    from large_set_arboricity import LargeSetArboricityIgraph
+    from graph_csr import networkx_to_csr
+    from multiqueue_peel import multiqueue_peel
+
+    print("\nTest 26.1: One worker with one queue is an exact minimum-degree peel")
+    G = nx.barabasi_albert_graph(2000, 4, seed=26)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    result = multiqueue_peel(offsets, neighbors, workers=1, queues_per_worker=1, batch=64)
+    ok = _is_min_degree_peel(offsets, neighbors, result['order'], result['degree_at_removal'])
+    ok &= result['rank_error_max'] == 0 and result['cross_decrements'] == 0
+    exact = LargeSetArboricityIgraph.from_networkx(G, engine='numba').compute_all_dk_optimized(verbose=False)[1]
+    ok &= np.array_equal(result['dk'], exact)
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+    print("\nTest 26.2: Reported rank errors equal a replay over the full degree range")
+    # Leaves over a core of spread-out degrees: once a queue runs out of
+    # leaves, its pops jump far above the other queues' minima
+    pendant = nx.gnm_random_graph(200, 4000, seed=26)
+    pendant.add_edges_from((v % 200, v) for v in range(200, 208))
+    for name, G, workers, batch in [("G(200, 4000) + 8 pendant leaves", pendant, 2, 16),("BA(3000, 6)", nx.barabasi_albert_graph(3000, 6, seed=26), 4, 16),
+                                    ("Power-law clustered(3000)",
+                                     nx.powerlaw_cluster_graph(3000, 5, 0.3, seed=26), 8, 4),
+                                    ("G(1500, 9000)", nx.gnm_random_graph(1500, 9000, seed=26), 3, 32)]:
+        offsets, neighbors, _ = networkx_to_csr(G)
+        result = multiqueue_peel(offsets, neighbors, workers=workers, batch=batch, seed=26)
+        expected = _replay_rank_errors(offsets, neighbors, result)
+        ok = np.array_equal(np.sort(result['order']), np.arange(G.number_of_nodes()))
+        ok &= np.array_equal(result['rank_error'], expected)
+        ok &= result['rank_error_max'] == int(expected.max())
+        print(f"  {name}: {workers} workers, {result['epochs']} epochs, max rank error "
+              f"{result['rank_error_max']} {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 26.3: The relaxed dk profile is a lower bound on αk")
+    G = nx.gnm_random_graph(12, 30, seed=26)
+    offsets, neighbors, _ = networkx_to_csr(G)
+    alpha = _brute_alpha(G)
+    ok = True
+    for seed in range(5):
+        result = multiqueue_peel(offsets, neighbors, workers=3, batch=2, seed=seed)
+        ok &= all(d <= a for d, a in zip(result['dk'], alpha))
+    lsa = LargeSetArboricityIgraph.from_networkx(G, engine='numba')
+    ok &= np.array_equal(lsa.compute_all_dk_multiqueue(workers=3, batch=2, verbose=False)[1],
+                         multiqueue_peel(offsets, neighbors, workers=3, batch=2)['dk'])
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+
+def test_prefetch_peel():
+    """Test that the prefetching peel kernels reproduce the plain bucket peel exactly."""
+    print("\n" + "="*70)
+    print("TEST 27: Prefetching Peel Kernels")
+    print("="*70)
+
+    from large_set_arboricity import _bucket_peel_csr, _bucket_peel_view, LargeSetArboricityIgraph
+    from prefetch_peel import _bucket_peel_prefetch_csr, _bucket_peel_prefetch_view
+    from graph_csr import networkx_to_csr
+
+    def same(a, b):
+        return len(a) == len(b) and all(np.array_equal(x, y) for x, y in zip(a, b))
+
+    isolated = nx.gnm_random_graph(300, 900, seed=27)
+    isolated.add_nodes_from(range(300, 340))
+    ba = nx.barabasi_albert_graph(2000, 5, seed=27)
+    relabelled = nx.relabel_nodes(
+        ba, dict(zip(ba.nodes(), np.random.default_rng(27).permutation(2000).tolist())))
+    graphs = [("BA(2000, 5)", ba),
+              ("BA(2000, 5) relabelled", relabelled),
+              ("G(1000, 8000)", nx.gnm_random_graph(1000, 8000, seed=27)),
+              ("Caveman(40, 8)", nx.connected_caveman_graph(40, 8)),
+              ("G(300, 900) + 40 isolated", isolated),
+              ("Empty(25)", nx.empty_graph(25))]
+
+    print("\nTest 27.1: Full-graph kernel equals _bucket_peel_csr at every distance")
+    for name, G in graphs:
+        offsets, neighbors, _ = networkx_to_csr(G)
+        expected = _bucket_peel_csr(offsets, neighbors)
+        ok = all(same(_bucket_peel_prefetch_csr(offsets, neighbors, d), expected)
+                 for d in (1, 4, 16, 64, 4096))
+        print(f"  {name}: {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 27.2: View kernel equals _bucket_peel_view on random masks")
+    rng = np.random.default_rng(27)
+    for name, G in graphs:
+        offsets, neighbors, _ = networkx_to_csr(G)
+        n = len(offsets) - 1
+        ok = True
+        for keep in (0.0, 0.3, 0.8, 1.0):
+            mask = rng.random(n) < keep
+            degrees = np.zeros(n, dtype=np.int64)
+            for v in np.flatnonzero(mask):
+                degrees[v] = mask[neighbors[offsets[v]:offsets[v + 1]]].sum()
+            # Both kernels decrement degrees in place
+            expected = _bucket_peel_view(offsets, neighbors, mask, degrees.copy())
+            ok &= all(same(_bucket_peel_prefetch_view(offsets, neighbors, mask, degrees.copy(), d),
+                           expected) for d in (1, 16, 4096))
+        print(f"  {name}: {'✓ PASS' if ok else '✗ FAIL'}")
+
+    print("\nTest 27.3: engine='prefetch' matches engine='numba' on the graph and a subset")
+    G = nx.powerlaw_cluster_graph(1500, 4, 0.3, seed=27)
+    plain = LargeSetArboricityIgraph.from_networkx(G, engine='numba')
+    fetch = LargeSetArboricityIgraph.from_networkx(G, engine='prefetch')
+    subset = list(range(0, 1500, 3))
+    ok = np.array_equal(plain.compute_all_dk_optimized(verbose=False)[1],
+                        fetch.compute_all_dk_optimized(verbose=False)[1])
+    ok &= same(plain.peel_csr(subset), fetch.peel_csr(subset))
+    ok &= same(plain.peel_csr(), fetch.peel_csr())
+    print(f"  ✓ PASS" if ok else f"  ✗ FAIL")
+
+
+def test_block_reader():
+    """Test the read-ahead block reader backends and its consumers."""
+    print("\n" + "="*70)
+    print("TEST 28: Block Reader")
+    print("="*70)
+
+    import os
+    import tempfile
+    from block_reader import BlockReader
+    from graph_csr import networkx_to_csr, save_arrays, iter_edge_chunks, edge_file_to_csr
+    from approximate_peel import approximate_peel_states, approximate_peel_states_file
+
+    backends = ['pread']
+    try:
+        BlockReader('io_uring').close()
+        backends.append('io_uring')
+    except OSError:
+        print("  (io_uring unavailable, testing pread only)")
+
+    G = nx.barabasi_albert_graph(3000, 5, seed=28)
+    with tempfile.TemporaryDirectory() as tmp:
+        # No trailing newline, so the last line is left in the carry
+        path = os.path.join(tmp, 'edges.txt')
+        with open(path, 'w') as f:
+            f.write("# comment\n" + "\n".join(f"{u} {v}" for u, v in G.edges()))
+        with open(path, 'rb') as f:
+            data = f.read()
+        empty = os.path.join(tmp, 'empty.txt')
+        open(empty, 'w').close()
+
+        print("\nTest 28.1: Every backend streams byte-identical ranges")
+        for backend in backends:
+            ok = True
+            for depth in (1, 4):
+                # Small blocks: many reads in flight, lines cut at block ends
+                with BlockReader(backend, queue_depth=depth, block_size=4096) as reader:
+                    ok &= reader.backend == backend
+                    ok &= b''.join(b.tobytes() for b in reader.blocks(path)) == data
+                    ok &= b''.join(b.tobytes() for b in reader.blocks(path, 12345, 50000)) == \
+                        data[12345:62345]
+                    ok &= b''.join(b.tobytes() for b in reader.blocks(empty)) == b''
+                    stats = reader.stats()
+                    ok &= stats['bytes'] == len(data) + 50000 and stats['passes'] == 3
+            print(f"  {backend}: {'✓ PASS' if ok else '✗ FAIL'}")
+
+        print("\nTest 28.2: The edge-list parser gives the same edges and CSR through the reader")
+        plain_chunks = np.concatenate(list(iter_edge_chunks(path, chunk_lines=1000)))
+        plain = edge_file_to_csr(path)
+        for backend in backends:
+            with BlockReader(backend, queue_depth=2, block_size=4096) as reader:
+                chunks = np.concatenate(list(iter_edge_chunks(path, reader=reader)))
+                csr = edge_file_to_csr(path, reader=reader)
+            ok = np.array_equal(chunks, plain_chunks)
+            ok &= all(np.array_equal(a, b) for a, b in zip(csr, plain))
+            print(f"  {backend}: {len(chunks)} edges {'✓ PASS' if ok else '✗ FAIL'}")
+
+        print("\nTest 28.3: Semi-external approximate peel equals the in-memory one")
+        offsets, neighbors, _ = networkx_to_csr(G)
+        cache = os.path.join(tmp, 'graph.bin')
+        save_arrays(cache, {'offsets': offsets, 'neighbors': neighbors})
+        V, E, layer = approximate_peel_states(offsets, neighbors, 0.1)
+        for backend in backends:
+            with BlockReader(backend, queue_depth=2, block_size=8192) as reader:
+                result = approximate_peel_states_file(cache, 0.1, reader=reader)
+            ok = np.array_equal(result['vertices_at_round'], V)
+            ok &= np.array_equal(result['edges_at_round'], E)
+            ok &= np.array_equal(result['round_of_vertex'], layer)
+            print(f"  {backend}: {result['rounds']} rounds, {result['io']['bytes']:,} bytes "
+                  f"{'✓ PASS' if ok else '✗ FAIL'}")
+
+
 def demonstrate_proof_construction():
     """Demonstrate the proof construction from the paper."""
     print("\n" + "="*70)
@@ -248,6 +1633,31 @@ def main():
     test_basic_properties()
     test_approximation_bounds()
     test_edge_cases()
+    test_top_t_dense_subgraphs()
+    test_pseudoarboricity()
+    test_h_partition()
+    test_sharded_peel()
+    test_graph_partition()
+    test_peel_engines()
+    test_snapshot_diff()
+    test_subset_views()
+    test_ego_networks()
+    test_batched_graphs()
+    test_exact_alpha_widths()
+    test_treewidth_dp()
+    test_degree_bounds()
+    test_anytime_bounds()
+    test_witness_api()
+    test_triangles()
+    test_graph_stats()
+    test_dataset_catalog()
+    test_residency()
+    test_versioned_graph()
+    test_update_log()
+    test_turnstile_sketch()
+    test_multiqueue_peel()
+    test_prefetch_peel()
+    test_block_reader()
     
     # Demonstrations
     demonstrate_proof_construction()
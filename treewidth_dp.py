@@ -0,0 +1,309 @@
+#!/usr/bin/env python3
+"""
+Exact αk via dynamic programming over a tree decomposition
+
+αk(G) = max_{s > k} ⌈2·f(s)/s⌉ where f(s) is the largest number of edges
+induced by s vertices. For graphs of small treewidth (road and
+infrastructure networks, grids, series-parallel graphs) f is computed
+for every s at once:
+
+1. Decomposition:  greedy elimination ordering (min-degree or min-fill);
+                   the bag of v is v plus its later neighbours in the
+                   filled graph N⁺(v), its parent the earliest of them
+2. DP:             table T_v[X][s] for X ⊆ N⁺(v) = max edges counted so far
+                   when X is the chosen part of N⁺(v) and s vertices are
+                   chosen among v and its eliminated descendants. Every edge
+                   is counted at its earlier-eliminated endpoint. Children
+                   are merged with max-plus convolutions over s, smaller
+                   table into larger
+3. Profile:        the roots' tables give f(s), s = 0 .. n
+
+Time and memory are O(2^w · n²) in the worst case, i.e. exponential only
+in the width w. When the heuristic width exceeds the threshold the solver
+declines and exact_alpha_auto() falls back to the bitset branch and bound
+(n ≤ 512).
+"""
+
+import heapq
+import time
+import numpy as np
+from typing import List, Optional, Tuple
+
+from exact_alpha import exact_alpha_profile, MAX_VERTICES
+
+_NEG = -(1 << 40)
+_TOO_WIDE = 1 << 62
+
+
+def elimination_order(offsets: np.ndarray, neighbors: np.ndarray,
+                      heuristic: str = 'min_fill',
+                      max_width: Optional[int] = None) -> Optional[Tuple[np.ndarray, List[List[int]], int]]:
+    """
+    Greedy elimination ordering and the bags it induces.
+
+    Args:
+        offsets: CSR offsets
+        neighbors: CSR neighbours
+        heuristic: 'min_degree' or 'min_fill'
+        max_width: Give up as soon as a bag exceeds max_width + 1 vertices
+
+    Returns:
+        (order, later_neighbors, width) with later_neighbors[v] = N⁺(v) in
+        elimination order, or None if max_width was exceeded
+    """
+    if heuristic not in ('min_degree', 'min_fill'):
+        raise ValueError(f"Unknown elimination heuristic: {heuristic}")
+    n = len(offsets) - 1
+    adj = [set(neighbors[offsets[v]:offsets[v + 1]].tolist()) for v in range(n)]
+    for v in range(n):
+        adj[v].discard(v)
+
+    def fill(v: int) -> int:
+        nbrs = list(adj[v])
+        missing = 0
+        for i, a in enumerate(nbrs):
+            for b in nbrs[i + 1:]:
+                if b not in adj[a]:
+                    missing += 1
+        return missing
+
+    def score(v: int) -> Tuple[int, int]:
+        if max_width is not None and len(adj[v]) > max_width:
+            # Eliminating v now would exceed max_width: never score its fill
+            return (_TOO_WIDE, len(adj[v]))
+        if heuristic == 'min_fill':
+            return (fill(v), len(adj[v]))
+        return (len(adj[v]), 0)
+
+    current = [score(v) for v in range(n)]
+    heap = [(current[v], v) for v in range(n)]
+    heapq.heapify(heap)
+    eliminated = np.zeros(n, dtype=bool)
+    position = np.empty(n, dtype=np.int64)
+    order = np.empty(n, dtype=np.int64)
+    later = [None] * n
+    width = 0
+
+    for step in range(n):
+        while True:
+            key, v = heapq.heappop(heap)
+            if not eliminated[v] and key == current[v]:
+                break
+        nbrs = list(adj[v])
+        if len(nbrs) > width:
+            width = len(nbrs)
+            if max_width is not None and width > max_width:
+                return None
+
+        eliminated[v] = True
+        position[v] = step
+        order[step] = v
+        later[v] = nbrs
+
+        # Make the neighbourhood a clique, then drop v
+        for i, a in enumerate(nbrs):
+            adj[a].discard(v)
+            for b in nbrs[i + 1:]:
+                if b not in adj[a]:
+                    adj[a].add(b)
+                    adj[b].add(a)
+
+        touched = set(nbrs)
+        if heuristic == 'min_fill':
+            for a in nbrs:
+                # Neighbours of a vertex too wide to eliminate keep their old
+                # fill (a heuristic score only) instead of rescanning a hub
+                if max_width is None or len(adj[a]) <= max_width:
+                    touched.update(adj[a])
+        for u in touched:
+            if not eliminated[u]:
+                current[u] = score(u)
+                heapq.heappush(heap, (current[u], u))
+
+    later_sorted = [sorted(later[v], key=lambda u: position[u]) for v in range(n)]
+    return order, later_sorted, width
+
+
+def _maxplus(a: np.ndarray, b: np.ndarray) -> np.ndarray:
+    """Row-wise max-plus convolution over the size axis."""
+    if a.shape[1] < b.shape[1]:
+        a, b = b, a
+    p = a.shape[1]
+    out = np.full((a.shape[0], p + b.shape[1] - 1), _NEG, dtype=np.int64)
+    for j in range(b.shape[1]):
+        np.maximum(out[:, j:j + p], a + b[:, j:j + 1], out=out[:, j:j + p])
+    return out
+
+
+def densest_by_size(offsets: np.ndarray, neighbors: np.ndarray,
+                    heuristic: str = 'min_fill',
+                    max_width: int = 10) -> Optional[Tuple[np.ndarray, int]]:
+    """
+    f(s) = max edges induced by s vertices, for every s, by tree-decomposition DP.
+
+    Args:
+        offsets: CSR offsets
+        neighbors: CSR neighbours
+        heuristic: Elimination heuristic ('min_degree' or 'min_fill')
+        max_width: Largest decomposition width accepted
+
+    Returns:
+        (f, width) with f int64[n+1], or None if the width exceeds max_width
+    """
+    n = len(offsets) - 1
+    if n > 0:
+        # Treewidth is at least the degeneracy: reject dense graphs in O(n + m)
+        from large_set_arboricity import _bucket_peel_csr  # that module imports this one
+        if int(_bucket_peel_csr(offsets, neighbors)[1].max()) > max_width:
+            return None
+    result = elimination_order(offsets, neighbors, heuristic, max_width)
+    if result is None:
+        return None
+    order, later, width = result
+
+    popcount = np.array([bin(i).count('1') for i in range(1 << (width + 1))], dtype=np.int64)
+    children = [[] for _ in range(n)]
+    roots = []
+    for v in order:
+        if later[v]:
+            children[later[v][0]].append(v)
+        else:
+            roots.append(v)
+
+    tables = [None] * n
+    for v in order:
+        sep = later[v]
+        bag = [v] + sep                          # bit i of Y = bag[i]
+        slot = {u: i for i, u in enumerate(bag)}
+        Y = np.arange(1 << len(bag), dtype=np.int64)
+
+        acc = np.zeros((len(Y), 1), dtype=np.int64)
+        for c in children[v]:
+            # Index of Y restricted to the child's separator
+            child_index = np.zeros(len(Y), dtype=np.int64)
+            for j, u in enumerate(later[c]):
+                child_index |= ((Y >> slot[u]) & 1) << j
+            acc = _maxplus(acc, tables[c][child_index])
+            tables[c] = None
+
+        # Edges from v to chosen later neighbours (original edges only)
+        original = set(neighbors[offsets[v]:offsets[v + 1]].tolist())
+        mask = 0
+        for j, u in enumerate(sep):
+            if u in original:
+                mask |= 1 << j
+        without = acc[0::2]
+        with_v = acc[1::2] + popcount[(Y[1::2] >> 1) & mask][:, None]
+
+        table = np.full((len(without), acc.shape[1] + 1), _NEG, dtype=np.int64)
+        table[:, :-1] = without
+        np.maximum(table[:, 1:], with_v, out=table[:, 1:])
+        tables[v] = table
+
+    total = np.zeros((1, 1), dtype=np.int64)
+    for r in roots:
+        total = _maxplus(total, tables[r])
+    return total[0], width
+
+
+def exact_alpha_treewidth(offsets: np.ndarray, neighbors: np.ndarray,
+                          heuristic: str = 'min_fill', max_width: int = 10,
+                          verbose: bool = False) -> Optional[dict]:
+    """
+    Exact αk for all k by tree-decomposition DP.
+
+    Args:
+        offsets: CSR offsets
+        neighbors: CSR neighbours
+        heuristic: Elimination heuristic ('min_degree' or 'min_fill')
+        max_width: Largest decomposition width accepted
+        verbose: Print progress information
+
+    Returns:
+        Dictionary with alpha (αk for k = 0 .. n-1), f (max edges per size)
+        and width, or None if the width exceeds max_width
+    """
+    start_time = time.time()
+    result = densest_by_size(offsets, neighbors, heuristic, max_width)
+    if result is None:
+        if verbose:
+            print(f"✗ {heuristic} decomposition wider than {max_width}, DP skipped")
+        return None
+    f, width = result
+
+    n = len(f) - 1
+    alpha = np.zeros(n, dtype=np.int64)
+    best = 0
+    for s in range(n, 0, -1):
+        best = max(best, -(-2 * int(f[s]) // s))
+        alpha[s - 1] = best
+
+    elapsed = time.time() - start_time
+    if verbose:
+        print(f"✓ Tree-decomposition DP ({heuristic}, width {width}) in {elapsed:.3f} seconds")
+        if n > 0:
+            print(f"  α_0 = {alpha[0]}")
+
+    return {'alpha': alpha, 'f': f, 'width': width, 'time': elapsed}
+
+
+def exact_alpha_auto(offsets: np.ndarray, neighbors: np.ndarray, max_width: int = 10,
+                     heuristic: str = 'min_fill',
+                     node_limit: int = 10_000_000) -> Tuple[Optional[np.ndarray], str]:
+    """
+    Exact αk profile with automatic solver choice.
+
+    Tree-decomposition DP if the heuristic width is at most max_width,
+    otherwise the bitset branch and bound if n ≤ 512.
+
+    Returns:
+        (alpha, method) with method 'treewidth', 'bitset' or 'none'
+        (alpha is None when no exact solver applies or the search budget ran out)
+    """
+    result = exact_alpha_treewidth(offsets, neighbors, heuristic, max_width)
+    if result is not None:
+        return result['alpha'], 'treewidth'
+
+    if len(offsets) - 1 <= MAX_VERTICES:
+        alpha, exact = exact_alpha_profile(offsets, neighbors, node_limit)
+        if exact:
+            return alpha, 'bitset'
+    return None, 'none'
+
+
+def exact_alpha_networkx_auto(G, max_width: int = 10,
+                              node_limit: int = 10_000_000) -> Tuple[Optional[np.ndarray], Optional[List[list]], str]:
+    """
+    Exact αk profile of a networkx graph for the LargeSetArboricity wrappers.
+
+    The bitset branch and bound runs first for n ≤ 512 because it also
+    yields a witness set per k; if the graph is larger or the search budget
+    runs out, the tree-decomposition DP runs when the heuristic width is at
+    most max_width.
+
+    Args:
+        G: networkx Graph (any node labels)
+        max_width: Largest decomposition width for the DP
+        node_limit: Search node budget of the bitset solver
+
+    Returns:
+        (alpha, witnesses, method) with witnesses[k] a list of node labels
+        (None for the DP) and method 'bitset', 'treewidth' or 'none'
+        (alpha is None when no exact solver applies)
+    """
+    from exact_alpha import exact_alpha_networkx
+    from graph_csr import networkx_to_csr
+
+    n = G.number_of_nodes()
+    if n == 0:
+        return np.zeros(0, dtype=np.int64), [], 'bitset'
+    if n <= MAX_VERTICES:
+        alpha, witnesses, exact = exact_alpha_networkx(G, node_limit)
+        if exact:
+            return alpha, witnesses, 'bitset'
+
+    offsets, neighbors, _ = networkx_to_csr(G)
+    result = exact_alpha_treewidth(offsets, neighbors, max_width=max_width)
+    if result is not None:
+        return result['alpha'], None, 'treewidth'
+    return None, None, 'none'
@@ -0,0 +1,397 @@
+#!/usr/bin/env python3
+"""
+Turnstile-stream sketch for approximate densest subgraph, α₀ and dk
+
+A stream of edge insertions and deletions that is never stored: every
+update is folded into a linear sketch, and the densest-subgraph
+quantities are estimated on demand from a uniform edge sample recovered
+from the sketch (McGregor et al. 2015; Bhattacharya et al. 2015).
+
+Sampling levels:
+    A hash of the edge decides its level; edge e belongs to levels
+    0..level(e), so level j holds a 2^-j uniform sample of the current
+    edge set, with an edge deleted from the very levels it was inserted
+    into. Each level is an invertible Bloom lookup table (IBLT) of
+    cells_per_vertex · n cells in three subtables:
+
+        count (int32) | key sum (uint64) | checksum sum (uint64)
+
+    An update adds ±(1, key, hash(key)) to one cell per subtable, key =
+    u·n + v for u < v. Sums wrap modulo 2^64, so the sketch is linear:
+    sketches of two update streams add up to the sketch of their union,
+    in any order, which is how worker threads and processes merge.
+
+Recovery:
+    A level is decoded by repeatedly taking a pure cell (count 1, checksum
+    matching its key sum) and subtracting its edge from its three cells;
+    it succeeds when every cell is back at zero, which holds with high
+    probability while the level's edges stay below ~0.8 of its cells.
+    estimate() decodes the densest level that succeeds, i.e. the largest
+    sampling rate p the memory allows.
+
+Estimates:
+    The densest subgraph of a p-sample has density ≈ p·ρ* within 1 ± ε
+    once p·ρ* ≥ c·log n / ε², which the default cells_per_vertex =
+    ⌈ln n / ε²⌉ provides at the chosen level (its p·m edges fill a fixed
+    fraction of its K·n cells and m ≤ n·ρ*). On the decoded sample:
+
+        α₀ ≈ ⌈2·ρ_sample / p⌉   ρ_sample from Greedy++ passes (anytime_bounds)
+        dk ≈ peel states of the sample with edge counts scaled by 1/p
+
+Memory is O(n · log n / ε² · log n) cells: polylogarithmic per vertex.
+The stream must be a strict turnstile stream of a simple graph: an edge
+is only deleted while present and never inserted twice.
+"""
+
+import math
+import time
+import numpy as np
+from numba import njit
+from typing import Optional
+
+from graph_csr import edges_to_csr, load_arrays, save_arrays
+from large_set_arboricity import _bucket_peel_csr, _compute_dk_from_states
+from anytime_bounds import _greedy_pp_pass
+
+
+_DECODE_LOAD = 0.8
+
+
+@njit(cache=True)
+def _mix(x: np.uint64) -> np.uint64:
+    """splitmix64 finaliser."""
+    x = (x ^ (x >> np.uint64(30))) * np.uint64(0xBF58476D1CE4E5B9)
+    x = (x ^ (x >> np.uint64(27))) * np.uint64(0x94D049BB133111EB)
+    return x ^ (x >> np.uint64(31))
+
+
+@njit(cache=True)
+def _cell(key: np.uint64, seed: np.uint64, r: int, sub: int) -> int:
+    """Cell of a key in subtable r (subtables are sub cells wide)."""
+    h = _mix(key ^ (seed + np.uint64(r + 2) * np.uint64(0x9E3779B97F4A7C15)))
+    return r * sub + int(h % np.uint64(sub))
+
+
+@njit(cache=True)
+def _checksum(key: np.uint64, seed: np.uint64) -> np.uint64:
+    return _mix(key ^ (seed + np.uint64(0xD6E8FEB86659FD93)))
+
+
+@njit(cache=True, nogil=True)
+def _update(counts: np.ndarray, key_sums: np.ndarray, check_sums: np.ndarray,
+            keys: np.ndarray, signs: np.ndarray, seed: np.uint64, sub: int) -> None:
+    """Add ±(1, key, checksum) to the three cells of every key on its levels."""
+    levels = counts.shape[0]
+    for i in range(len(keys)):
+        key = np.uint64(keys[i])
+        sign = signs[i]
+        h = _mix(key ^ seed)
+        top = 0
+        while top < levels - 1 and (h >> np.uint64(63)) == np.uint64(0):
+            h = h << np.uint64(1)
+            top += 1
+        check = _checksum(key, seed)
+        for r in range(3):
+            c = _cell(key, seed, r, sub)
+            for j in range(top + 1):
+                counts[j, c] += sign
+                if sign > 0:
+                    key_sums[j, c] += key
+                    check_sums[j, c] += check
+                else:
+                    key_sums[j, c] -= key
+                    check_sums[j, c] -= check
+
+
+@njit(cache=True)
+def _decode(counts: np.ndarray, key_sums: np.ndarray, check_sums: np.ndarray,
+            seed: np.uint64, sub: int, n: int):
+    """
+    Peel one IBLT level.
+
+    Returns:
+        (keys, ok): recovered keys and whether the level emptied completely
+    """
+    counts = counts.copy()
+    key_sums = key_sums.copy()
+    check_sums = check_sums.copy()
+    cells = len(counts)
+    limit = np.uint64(n) * np.uint64(n)
+
+    keys = np.empty(cells, dtype=np.int64)
+    found = 0
+    stack = np.empty(cells + 3 * cells, dtype=np.int64)
+    sp = 0
+    for c in range(cells):
+        if counts[c] == 1:
+            stack[sp] = c
+            sp += 1
+
+    while sp > 0:
+        sp -= 1
+        c = stack[sp]
+        if counts[c] != 1:
+            continue
+        key = key_sums[c]
+        if key >= limit or check_sums[c] != _checksum(key, seed):
+            continue
+        if found == cells:
+            return keys[:found], False
+        keys[found] = np.int64(key)
+        found += 1
+        check = check_sums[c]
+        for r in range(3):
+            d = _cell(key, seed, r, sub)
+            counts[d] -= 1
+            key_sums[d] -= key
+            check_sums[d] -= check
+            if counts[d] == 1 and sp < len(stack):
+                stack[sp] = d
+                sp += 1
+
+    for c in range(cells):
+        if counts[c] != 0 or key_sums[c] != np.uint64(0):
+            return keys[:found], False
+    return keys[:found], True
+
+
+class TurnstileDensestSketch:
+    """
+    Linear sketch of a turnstile edge stream for densest-subgraph estimates.
+    """
+
+    def __init__(self, n: int, epsilon: float = 0.5, cells_per_vertex: Optional[int] = None,
+                 levels: Optional[int] = None, seed: int = 0):
+        """
+        Args:
+            n: Number of vertices (ids 0..n-1)
+            epsilon: Target relative error ε
+            cells_per_vertex: IBLT cells per vertex and level (default ⌈ln n / ε²⌉)
+            levels: Sampling levels (default: enough for p·m to fit at m = n²/2)
+            seed: Hash seed; sketches merge only with equal n, sizes and seed
+        """
+        self.n = n
+        self.epsilon = epsilon
+        if cells_per_vertex is None:
+            cells_per_vertex = max(4, math.ceil(math.log(max(n, 2)) / epsilon ** 2))
+        self.cells_per_vertex = cells_per_vertex
+        self.sub = max(1, -(-cells_per_vertex * n // 3))
+        if levels is None:
+            # Level j fits m·2^-j ≤ 0.8·3·sub edges for any m ≤ n²/2
+            levels = max(1, math.ceil(math.log2(max(n * n / (2 * _DECODE_LOAD * 3 * self.sub), 1))) + 1)
+        self.levels = levels
+        self.seed = seed
+
+        self.counts = np.zeros((levels, 3 * self.sub), dtype=np.int32)
+        self.key_sums = np.zeros((levels, 3 * self.sub), dtype=np.uint64)
+        self.check_sums = np.zeros((levels, 3 * self.sub), dtype=np.uint64)
+        self.m = 0
+        self.updates = 0
+
+    @property
+    def memory_bytes(self) -> int:
+        return self.counts.nbytes + self.key_sums.nbytes + self.check_sums.nbytes
+
+    def _keys(self, edges) -> np.ndarray:
+        edges = np.asarray(edges, dtype=np.int64).reshape(-1, 2)
+        if len(edges) > 0 and (edges.min() < 0 or edges.max() >= self.n):
+            raise ValueError(f"Edge endpoint outside 0..{self.n - 1}")
+        lo = np.minimum(edges[:, 0], edges[:, 1])
+        hi = np.maximum(edges[:, 0], edges[:, 1])
+        keep = lo != hi
+        return lo[keep] * self.n + hi[keep]
+
+    def update(self, edges, signs) -> None:
+        """
+        Apply a batch of updates (self-loops are ignored).
+
+        Args:
+            edges: (k, 2) edges
+            signs: +1 (insertion) or -1 (deletion) per edge, or one value for all
+        """
+        edges = np.asarray(edges, dtype=np.int64).reshape(-1, 2)
+        signs = np.broadcast_to(np.asarray(signs, dtype=np.int32), (len(edges),))
+        keys = self._keys(edges)
+        signs = np.ascontiguousarray(signs[edges[:, 0] != edges[:, 1]])
+        _update(self.counts, self.key_sums, self.check_sums, keys, signs,
+                np.uint64(self.seed), self.sub)
+        self.m += int(signs.sum())
+        self.updates += len(keys)
+
+    def insert(self, edges) -> None:
+        self.update(edges, 1)
+
+    def delete(self, edges) -> None:
+        self.update(edges, -1)
+
+    def merge(self, other: 'TurnstileDensestSketch') -> 'TurnstileDensestSketch':
+        """
+        Add another sketch of the same shape and seed (e.g. from another worker).
+
+        Returns:
+            self
+        """
+        if (other.n, other.sub, other.levels, other.seed) != (self.n, self.sub, self.levels, self.seed):
+            raise ValueError("Sketches differ in n, size, levels or seed")
+        self.counts += other.counts
+        self.key_sums += other.key_sums
+        self.check_sums += other.check_sums
+        self.m += other.m
+        self.updates += other.updates
+        return self
+
+    def __iadd__(self, other: 'TurnstileDensestSketch') -> 'TurnstileDensestSketch':
+        return self.merge(other)
+
+    def save(self, path: str) -> int:
+        """
+        Write the sketch with save_arrays() (for merging across processes).
+
+        Returns:
+            File size in bytes
+        """
+        meta = np.array([self.n, self.cells_per_vertex, self.levels, self.seed, self.m,
+                         self.updates], dtype=np.int64)
+        return save_arrays(path, {'meta': meta, 'epsilon': np.array([self.epsilon]),
+                                  'counts': self.counts, 'key_sums': self.key_sums,
+                                  'check_sums': self.check_sums})
+
+    @classmethod
+    def load(cls, path: str) -> 'TurnstileDensestSketch':
+        """Read a sketch written by save()."""
+        arrays = load_arrays(path, mmap=False)
+        n, cells_per_vertex, levels, seed, m, updates = (int(x) for x in arrays['meta'])
+        sketch = cls(n, float(arrays['epsilon'][0]), cells_per_vertex, levels, seed)
+        shape = sketch.counts.shape
+        sketch.counts = arrays['counts'].reshape(shape)
+        sketch.key_sums = arrays['key_sums'].reshape(shape)
+        sketch.check_sums = arrays['check_sums'].reshape(shape)
+        sketch.m = m
+        sketch.updates = updates
+        return sketch
+
+    def sample(self) -> dict:
+        """
+        Decode the densest sampling level that can be recovered completely.
+
+        Returns:
+            Dictionary with level, rate (p = 2^-level), edges ((k, 2) sample)
+            and attempts (levels tried)
+        """
+        capacity = _DECODE_LOAD * 3 * self.sub
+        start = 0
+        while start < self.levels - 1 and self.m * 2.0 ** -start > capacity:
+            start += 1
+
+        seed = np.uint64(self.seed)
+        for level in range(start, self.levels):
+            keys, ok = _decode(self.counts[level], self.key_sums[level], self.check_sums[level],
+                               seed, self.sub, self.n)
+            if ok:
+                edges = np.stack((keys // self.n, keys % self.n), axis=1)
+                return {'level': level, 'rate': 2.0 ** -level, 'edges': edges,
+                        'attempts': level - start + 1}
+        raise RuntimeError("No sampling level could be decoded; add cells or levels")
+
+    def estimate(self, greedy_iterations: int = 8, verbose: bool = False) -> dict:
+        """
+        Approximate α₀, densest-subgraph density and dk from the recovered sample.
+
+        Args:
+            greedy_iterations: Greedy++ passes over the sample
+            verbose: Print a summary
+
+        Returns:
+            Dictionary with alpha_0, density (edges per vertex), dk (int64[n]),
+            level, rate, sample_edges, m (exact current edge count) and time
+        """
+        start_time = time.time()
+        sample = self.sample()
+        rate = sample['rate']
+        offsets, neighbors = edges_to_csr(sample['edges'], self.n)
+
+        _, _, sv, se, _ = _bucket_peel_csr(offsets, neighbors)
+        dk = np.ceil(_compute_dk_from_states(sv, se / rate, self.n)).astype(np.int64)
+
+        # Densest state over Greedy++ passes (the first pass is the plain peel)
+        best = 0.0
+        load = np.zeros(self.n, dtype=np.int64)
+        for _ in range(greedy_iterations):
+            gv, ge = _greedy_pp_pass(offsets, neighbors, load)
+            if len(gv) > 0:
+                best = max(best, float(np.max(ge / gv)))
+        density = best / rate
+
+        result = {
+            'alpha_0': int(math.ceil(2 * density - 1e-9)),
+            'density': density,
+            'dk': dk,
+            'level': sample['level'],
+            'rate': rate,
+            'sample_edges': len(sample['edges']),
+            'm': self.m,
+            'time': time.time() - start_time
+        }
+        if verbose:
+            print(f"✓ Decoded level {result['level']} (p = {rate:g}, "
+                  f"{result['sample_edges']:,} of {self.m:,} edges) in {result['time']:.3f} seconds")
+            print(f"  α₀ ≈ {result['alpha_0']} (densest subgraph density ≈ {density:.2f})")
+        return result
+
+
+if __name__ == "__main__":
+    from concurrent.futures import ThreadPoolExecutor
+    import igraph as ig
+    from graph_csr import igraph_to_csr
+
+    # Turnstile stream: the graph's edges plus noise edges that are later deleted,
+    # shuffled and split across workers; each worker sketches its part
+    n = 20_000
+    G = ig.Graph.Barabasi(n, 50)
+    edges = np.array(G.get_edgelist(), dtype=np.int64)
+    rng = np.random.default_rng(0)
+    noise = rng.integers(0, n, size=(len(edges) // 2, 2))
+    noise = noise[noise[:, 0] != noise[:, 1]]
+    noise_keys = np.unique(np.minimum(noise[:, 0], noise[:, 1]) * n + np.maximum(noise[:, 0], noise[:, 1]))
+    edge_keys = np.minimum(edges[:, 0], edges[:, 1]) * n + np.maximum(edges[:, 0], edges[:, 1])
+    noise_keys = np.setdiff1d(noise_keys, edge_keys)
+    noise = np.stack((noise_keys // n, noise_keys % n), axis=1)
+
+    workers = 4
+    parts = np.array_split(rng.permutation(len(edges)), workers)
+    noise_parts = np.array_split(rng.permutation(len(noise)), workers)
+
+    def sketch_part(w):
+        sketch = TurnstileDensestSketch(n)
+        sketch.insert(noise[noise_parts[w]])
+        sketch.insert(edges[parts[w]])
+        sketch.delete(noise[noise_parts[(w + 1) % workers]])
+        return sketch
+
+    print(f"\n{'='*70}")
+    print(f"Turnstile sketch: Barabási–Albert n={n:,}, m={len(edges):,}, "
+          f"{len(noise):,} noise edges inserted then deleted")
+    print(f"{'='*70}")
+    # Warm up the update kernel so compilation is not timed
+    TurnstileDensestSketch(4).insert([(0, 1)])
+    start_time = time.time()
+    with ThreadPoolExecutor(workers) as pool:
+        sketches = list(pool.map(sketch_part, range(workers)))
+    merged = sketches[0]
+    for other in sketches[1:]:
+        merged += other
+    print(f"✓ {merged.updates:,} updates on {workers} workers, merged in "
+          f"{time.time() - start_time:.2f}s; sketch {merged.memory_bytes / 2**20:.0f} MB "
+          f"({merged.levels} levels × {3 * merged.sub:,} cells)")
+    result = merged.estimate(verbose=True)
+
+    offsets, neighbors = igraph_to_csr(G)
+    _, _, pv, pe, _ = _bucket_peel_csr(offsets, neighbors)
+    exact_dk = _compute_dk_from_states(pv, pe, n)
+    load = np.zeros(n, dtype=np.int64)
+    exact_density = max(float(np.max(ge / gv))
+                        for gv, ge in (_greedy_pp_pass(offsets, neighbors, load) for _ in range(8)))
+    print(f"  Exact graph: α₀ ≥ {math.ceil(2 * exact_density - 1e-9)} "
+          f"(density {exact_density:.2f}), d0 = {exact_dk[0]}")
+    for k in (0, n // 100, n // 10, n // 2):
+        print(f"  d{k}: estimate {result['dk'][k]}, exact {exact_dk[k]}")